@@ -130,7 +130,18 @@ int BlowfishEngine::Encrypt(void const * plaintext, int length, void * cyphertex
 
         int blocks = length / BYTES_PER_BLOCK;
 
-        for (int index = 0; index < blocks; index++) {
+        /**
+         *  Process the blocks in pairs first, the two independent blocks
+         *  interleave their table lookups which hides much of the latency.
+         */
+        int index = 0;
+        for (; index+1 < blocks; index += 2) {
+            Process_Block_Pair(plaintext, cyphertext, P_Encrypt);
+            plaintext = ((char *)plaintext) + BYTES_PER_BLOCK*2;
+            cyphertext = ((char *)cyphertext) + BYTES_PER_BLOCK*2;
+        }
+
+        for (; index < blocks; index++) {
             Process_Block(plaintext, cyphertext, P_Encrypt);
             plaintext = ((char *)plaintext) + BYTES_PER_BLOCK;
             cyphertext = ((char *)cyphertext) + BYTES_PER_BLOCK;
@@ -166,7 +177,18 @@ int BlowfishEngine::Decrypt(void const * cyphertext, int length, void * plaintex
 
         int blocks = length / BYTES_PER_BLOCK;
 
-        for (int index = 0; index < blocks; index++) {
+        /**
+         *  Process the blocks in pairs first, the two independent blocks
+         *  interleave their table lookups which hides much of the latency.
+         */
+        int index = 0;
+        for (; index+1 < blocks; index += 2) {
+            Process_Block_Pair(cyphertext, plaintext, P_Decrypt);
+            cyphertext = ((char *)cyphertext) + BYTES_PER_BLOCK*2;
+            plaintext = ((char *)plaintext) + BYTES_PER_BLOCK*2;
+        }
+
+        for (; index < blocks; index++) {
             Process_Block(cyphertext, plaintext, P_Decrypt);
             cyphertext = ((char *)cyphertext) + BYTES_PER_BLOCK;
             plaintext = ((char *)plaintext) + BYTES_PER_BLOCK;
@@ -226,6 +248,79 @@ void BlowfishEngine::Process_Block(void const * plaintext, void * cyphertext, un
 }
 
 
+/**
+ *  Processes two consecutive blocks at once. The result is identical to
+ *  calling Process_Block for each block, but as the blocks do not depend on
+ *  each other their rounds can be executed in parallel by the processor.
+ */
+void BlowfishEngine::Process_Block_Pair(void const * plaintext, void * cyphertext, unsigned long const * ptable)
+{
+    unsigned char const * source = (unsigned char const *)plaintext;
+    Int left1;
+    left1.Char.C0 = source[0];
+    left1.Char.C1 = source[1];
+    left1.Char.C2 = source[2];
+    left1.Char.C3 = source[3];
+
+    Int right1;
+    right1.Char.C0 = source[4];
+    right1.Char.C1 = source[5];
+    right1.Char.C2 = source[6];
+    right1.Char.C3 = source[7];
+
+    Int left2;
+    left2.Char.C0 = source[8];
+    left2.Char.C1 = source[9];
+    left2.Char.C2 = source[10];
+    left2.Char.C3 = source[11];
+
+    Int right2;
+    right2.Char.C0 = source[12];
+    right2.Char.C1 = source[13];
+    right2.Char.C2 = source[14];
+    right2.Char.C3 = source[15];
+
+    for (int index = 0; index < ROUNDS/2; index++) {
+        unsigned long p0 = *ptable++;
+        unsigned long p1 = *ptable++;
+        left1.Long ^= p0;
+        left2.Long ^= p0;
+        right1.Long ^= ((( bf_S[0][left1.Char.C0] + bf_S[1][left1.Char.C1]) ^ bf_S[2][left1.Char.C2]) + bf_S[3][left1.Char.C3]);
+        right2.Long ^= ((( bf_S[0][left2.Char.C0] + bf_S[1][left2.Char.C1]) ^ bf_S[2][left2.Char.C2]) + bf_S[3][left2.Char.C3]);
+        right1.Long ^= p1;
+        right2.Long ^= p1;
+        left1.Long ^= ((( bf_S[0][right1.Char.C0] + bf_S[1][right1.Char.C1]) ^ bf_S[2][right1.Char.C2]) + bf_S[3][right1.Char.C3]);
+        left2.Long ^= ((( bf_S[0][right2.Char.C0] + bf_S[1][right2.Char.C1]) ^ bf_S[2][right2.Char.C2]) + bf_S[3][right2.Char.C3]);
+    }
+
+    left1.Long ^= *ptable;
+    left2.Long ^= *ptable++;
+    right1.Long ^= *ptable;
+    right2.Long ^= *ptable;
+
+    unsigned char * out = (unsigned char *)cyphertext;
+    out[0] = right1.Char.C0;
+    out[1] = right1.Char.C1;
+    out[2] = right1.Char.C2;
+    out[3] = right1.Char.C3;
+
+    out[4] = left1.Char.C0;
+    out[5] = left1.Char.C1;
+    out[6] = left1.Char.C2;
+    out[7] = left1.Char.C3;
+
+    out[8] = right2.Char.C0;
+    out[9] = right2.Char.C1;
+    out[10] = right2.Char.C2;
+    out[11] = right2.Char.C3;
+
+    out[12] = left2.Char.C0;
+    out[13] = left2.Char.C1;
+    out[14] = left2.Char.C2;
+    out[15] = left2.Char.C3;
+}
+
+
 void BlowfishEngine::Sub_Key_Encrypt(unsigned long & left, unsigned long & right)
 {
     Int l;
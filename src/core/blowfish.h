@@ -62,6 +62,7 @@ class BlowfishEngine
 
         void Sub_Key_Encrypt(unsigned long & left, unsigned long & right);
         void Process_Block(void const * plaintext, void * cyphertext, unsigned long const * ptable);
+        void Process_Block_Pair(void const * plaintext, void * cyphertext, unsigned long const * ptable);
 
     private:
         static unsigned long const P_Init[(int)ROUNDS+2];
@@ -34,6 +34,7 @@
  ******************************************************************************/
 #include "blowstraw.h"
 #include "asserthandler.h"
+#include <cstring>
 
 
 int BlowStraw::Get(void * source, int slen)
@@ -60,8 +61,45 @@ int BlowStraw::Get(void * source, int slen)
         }
         if (slen == 0) break;
 
-        int incount = Straw::Get(Buffer, sizeof(Buffer));
-        if (incount == 0) break;
+        int incount = 0;
+
+        /**
+         *  Read as many whole blocks as the request allows straight into the
+         *  destination and process them in place, rather than one block at a
+         *  time through the holding buffer.
+         */
+        if (slen >= (int)sizeof(Buffer)) {
+            int span = slen - (slen % sizeof(Buffer));
+
+            incount = Straw::Get(source, span);
+            if (incount == 0) break;
+
+            int blocklen = incount - (incount % sizeof(Buffer));
+            if (blocklen > 0) {
+                if (Control == DECRYPT) {
+                    BF->Decrypt(source, blocklen, source);
+                } else {
+                    BF->Encrypt(source, blocklen, source);
+                }
+                source = ((char *)source) + blocklen;
+                slen -= blocklen;
+                total += blocklen;
+            }
+
+            /**
+             *  A partial block was returned, complete it through the holding buffer
+             *  so it is handled exactly as if it had been read on its own.
+             */
+            int remainder = incount - blocklen;
+            if (remainder == 0) continue;
+
+            std::memmove(Buffer, source, remainder);
+            incount = remainder + Straw::Get(&Buffer[remainder], sizeof(Buffer)-remainder);
+
+        } else {
+            incount = Straw::Get(Buffer, sizeof(Buffer));
+            if (incount == 0) break;
+        }
 
         if (incount == sizeof(Buffer)) {
             if (Control == DECRYPT) {
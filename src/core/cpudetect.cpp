@@ -33,6 +33,7 @@
 #include <Windows.h>
 #include <cstdio>
 #include <cstring>
+#include <immintrin.h>
 
 
 namespace
@@ -316,6 +317,8 @@ bool CPUDetectClass::HasCPUIDInstruction = false;
 bool CPUDetectClass::HasRDTSCInstruction = false;
 bool CPUDetectClass::HasSSESupport = false;
 bool CPUDetectClass::HasSSE2Support = false;
+bool CPUDetectClass::HasSSSE3Support = false;
+bool CPUDetectClass::HasAVX2Support = false;
 bool CPUDetectClass::HasCMOVSupport = false;
 bool CPUDetectClass::HasMMXSupport = false;
 bool CPUDetectClass::Has3DNowSupport = false;
@@ -1274,7 +1277,21 @@ void CPUDetectClass::Init_Processor_Features()
     HasMMXSupport = (!!(FeatureBits & (1 << 23)));
     HasSSESupport = !!(FeatureBits & (1 << 25));
     HasSSE2Support = !!(FeatureBits & (1 << 26));
+    HasSSSE3Support = !!(id.ecx & (1 << 9));
     Has3DNowSupport = false;
+
+    /**
+     *  AVX2 also requires the OS to save the extended register state (OSXSAVE),
+     *  which is confirmed by checking the XMM and YMM bits of XCR0.
+     */
+    HasAVX2Support = false;
+    if ((id.ecx & (1 << 27)) && (id.ecx & (1 << 28))) {
+        CPUIDStruct max_id(0);
+        if (max_id.eax >= 7 && (_xgetbv(0) & 0x6) == 0x6) {
+            CPUIDCountStruct ext_features(7, 0);
+            HasAVX2Support = !!(ext_features.ebx & (1 << 5));
+        }
+    }
     ExtendedFeatureBits = 0;
 
     if (ProcessorManufacturer == MANUFACTURER_AMD) {
@@ -1430,6 +1447,8 @@ void CPUDetectClass::Init_Processor_Log()
     CPU_LOG("MMX: %s\r\n", CPUDetectClass::Has_MMX_Instruction_Set() ? "Yes" : "No");
     CPU_LOG("SSE: %s\r\n", CPUDetectClass::Has_SSE_Instruction_Set() ? "Yes" : "No");
     CPU_LOG("SSE2: %s\r\n", CPUDetectClass::Has_SSE2_Instruction_Set() ? "Yes" : "No");
+    CPU_LOG("SSSE3: %s\r\n", CPUDetectClass::Has_SSSE3_Instruction_Set() ? "Yes" : "No");
+    CPU_LOG("AVX2: %s\r\n", CPUDetectClass::Has_AVX2_Instruction_Set() ? "Yes" : "No");
     CPU_LOG("3DNow!: %s\r\n", CPUDetectClass::Has_3DNow_Instruction_Set() ? "Yes" : "No");
     CPU_LOG("Extended 3DNow!: %s\r\n", CPUDetectClass::Has_Extended_3DNow_Instruction_Set() ? "Yes" : "No");
     CPU_LOG("CPU Feature bits: 0x%x\r\n", CPUDetectClass::Get_Feature_Bits());
@@ -146,6 +146,8 @@ class CPUDetectClass
         static bool Has_MMX_Instruction_Set() { return HasMMXSupport; }
         static bool Has_SSE_Instruction_Set() { return HasSSESupport; }
         static bool Has_SSE2_Instruction_Set() { return HasSSE2Support; }
+        static bool Has_SSSE3_Instruction_Set() { return HasSSSE3Support; }
+        static bool Has_AVX2_Instruction_Set() { return HasAVX2Support; }
         static bool Has_3DNow_Instruction_Set() { return Has3DNowSupport; }
         static bool Has_Extended_3DNow_Instruction_Set() { return HasExtended3DNowSupport; }
 
@@ -296,6 +298,8 @@ class CPUDetectClass
         static bool HasRDTSCInstruction;
         static bool HasSSESupport;
         static bool HasSSE2Support;
+        static bool HasSSSE3Support;
+        static bool HasAVX2Support;
         static bool HasCMOVSupport;
         static bool HasMMXSupport;
         static bool Has3DNowSupport;
@@ -0,0 +1,203 @@
+/*******************************************************************************
+/*                 O P E N  S O U R C E  --  V I N I F E R A                  **
+/*******************************************************************************
+ *
+ *  @project       Vinifera
+ *
+ *  @file          CPUDISPATCH.CPP
+ *
+ *  @author        CCHyper
+ *
+ *  @brief         Runtime selection of instruction set specific routines.
+ *
+ *  @license       Vinifera is free software: you can redistribute it and/or
+ *                 modify it under the terms of the GNU General Public License
+ *                 as published by the Free Software Foundation, either version
+ *                 3 of the License, or (at your option) any later version.
+ *
+ *                 Vinifera is distributed in the hope that it will be
+ *                 useful, but WITHOUT ANY WARRANTY; without even the implied
+ *                 warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *                 PURPOSE. See the GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public
+ *                 License along with this program.
+ *                 If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#include "cpudispatch.h"
+#include "cpudetect.h"
+#include "debughandler.h"
+#include "asserthandler.h"
+#include <cstring>
+
+
+/**
+ *  These are constant initialised, so they are valid before any kernel registers itself.
+ */
+CPUDispatchClass *CPUDispatchClass::Head = nullptr;
+CPUTierType CPUDispatchClass::ForcedTier = CPU_TIER_NONE;
+
+
+static const char *CPUTierNames[CPU_TIER_COUNT] = {
+    "SCALAR",
+    "SSE2",
+    "SSSE3",
+    "AVX2"
+};
+
+
+/**
+ *  Registers the kernel and binds it to the scalar reference.
+ *
+ *  @author: CCHyper
+ */
+CPUDispatchClass::CPUDispatchClass(const char *name, void *scalar, void *sse2, void *ssse3, void *avx2) :
+    KernelName(name),
+    Bound(scalar),
+    BoundTier(CPU_TIER_SCALAR),
+    Next(Head)
+{
+    Variants[CPU_TIER_SCALAR] = scalar;
+    Variants[CPU_TIER_SSE2] = sse2;
+    Variants[CPU_TIER_SSSE3] = ssse3;
+    Variants[CPU_TIER_AVX2] = avx2;
+
+    Head = this;
+}
+
+
+/**
+ *  Returns the highest tier the processor supports.
+ *
+ *  @author: CCHyper
+ */
+CPUTierType CPUDispatchClass::Supported_Tier()
+{
+    if (CPUDetectClass::Has_AVX2_Instruction_Set() && CPUDetectClass::Has_SSSE3_Instruction_Set()) {
+        return CPU_TIER_AVX2;
+    }
+    if (CPUDetectClass::Has_SSSE3_Instruction_Set() && CPUDetectClass::Has_SSE2_Instruction_Set()) {
+        return CPU_TIER_SSSE3;
+    }
+    if (CPUDetectClass::Has_SSE2_Instruction_Set()) {
+        return CPU_TIER_SSE2;
+    }
+    return CPU_TIER_SCALAR;
+}
+
+
+/**
+ *  Returns the highest tier kernels may be bound to, taking any override into account.
+ *
+ *  @author: CCHyper
+ */
+CPUTierType CPUDispatchClass::Active_Tier()
+{
+    CPUTierType tier = Supported_Tier();
+
+    /**
+     *  The override can only lower the tier, forcing a tier the processor
+     *  does not support would crash on the first call.
+     */
+    if (ForcedTier != CPU_TIER_NONE && ForcedTier < tier) {
+        tier = ForcedTier;
+    }
+
+    return tier;
+}
+
+
+/**
+ *  Converts a tier name (as used on the command line and in VINIFERA.INI) to its type.
+ *
+ *  @author: CCHyper
+ */
+CPUTierType CPUDispatchClass::Tier_From_Name(const char *name)
+{
+    if (name == nullptr) {
+        return CPU_TIER_NONE;
+    }
+
+    for (int i = 0; i < CPU_TIER_COUNT; ++i) {
+        if (stricmp(name, CPUTierNames[i]) == 0) {
+            return CPUTierType(i);
+        }
+    }
+
+    return CPU_TIER_NONE;
+}
+
+
+/**
+ *  Returns the name of the tier.
+ *
+ *  @author: CCHyper
+ */
+const char *CPUDispatchClass::Name_From_Tier(CPUTierType tier)
+{
+    if (tier < CPU_TIER_SCALAR || tier >= CPU_TIER_COUNT) {
+        return "<none>";
+    }
+    return CPUTierNames[tier];
+}
+
+
+/**
+ *  Binds the kernel to the best available variant that passes its self test.
+ *
+ *  @author: CCHyper
+ */
+void CPUDispatchClass::Bind(CPUTierType max_tier)
+{
+    ASSERT_FATAL_PRINT(Variants[CPU_TIER_SCALAR] != nullptr, "Kernel \"%s\" has no scalar reference!", KernelName);
+
+    Bound = Variants[CPU_TIER_SCALAR];
+    BoundTier = CPU_TIER_SCALAR;
+
+    for (int i = CPU_TIER_SCALAR+1; i <= max_tier; ++i) {
+
+        CPUTierType tier = CPUTierType(i);
+
+        if (Variants[tier] == nullptr) {
+            continue;
+        }
+
+        /**
+         *  A variant that disagrees with the reference is never used, this also
+         *  stops it from being picked up by a later call to Bind_All.
+         */
+        if (!Test_Variant(tier)) {
+            DEBUG_ERROR("CPUDispatch: \"%s\" %s variant failed its self test, disabling it.\n", KernelName, Name_From_Tier(tier));
+            Variants[tier] = nullptr;
+            continue;
+        }
+
+        Bound = Variants[tier];
+        BoundTier = tier;
+    }
+}
+
+
+/**
+ *  Binds every registered kernel to the best variant for this processor.
+ * 
+ *  @warning: Must not be called while any kernel is in use on another thread.
+ *
+ *  @author: CCHyper
+ */
+void CPUDispatchClass::Bind_All()
+{
+    CPUTierType supported = Supported_Tier();
+    CPUTierType active = Active_Tier();
+
+    DEBUG_INFO("CPUDispatch: Supported tier is %s.\n", Name_From_Tier(supported));
+    if (active != supported) {
+        DEBUG_INFO("CPUDispatch: Tier limited to %s by user override.\n", Name_From_Tier(active));
+    }
+
+    for (CPUDispatchClass *kernel = Head; kernel != nullptr; kernel = kernel->Next) {
+        kernel->Bind(active);
+        DEBUG_INFO("CPUDispatch: \"%s\" bound to %s.\n", kernel->KernelName, Name_From_Tier(kernel->BoundTier));
+    }
+}
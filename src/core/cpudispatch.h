@@ -0,0 +1,145 @@
+/*******************************************************************************
+/*                 O P E N  S O U R C E  --  V I N I F E R A                  **
+/*******************************************************************************
+ *
+ *  @project       Vinifera
+ *
+ *  @file          CPUDISPATCH.H
+ *
+ *  @author        CCHyper
+ *
+ *  @brief         Runtime selection of instruction set specific routines.
+ *
+ *  @license       Vinifera is free software: you can redistribute it and/or
+ *                 modify it under the terms of the GNU General Public License
+ *                 as published by the Free Software Foundation, either version
+ *                 3 of the License, or (at your option) any later version.
+ *
+ *                 Vinifera is distributed in the hope that it will be
+ *                 useful, but WITHOUT ANY WARRANTY; without even the implied
+ *                 warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *                 PURPOSE. See the GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public
+ *                 License along with this program.
+ *                 If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include "always.h"
+
+
+/**
+ *  The instruction set tiers a routine can provide a variant for, in
+ *  ascending order of preference.
+ */
+typedef enum CPUTierType
+{
+    CPU_TIER_NONE = -1,
+
+    CPU_TIER_SCALAR,
+    CPU_TIER_SSE2,
+    CPU_TIER_SSSE3,
+    CPU_TIER_AVX2,
+
+    CPU_TIER_COUNT
+} CPUTierType;
+
+
+/**
+ *  A single dispatchable routine. Instances register themselves on construction,
+ *  so kernels should be declared at file scope using CPUDispatchKernel. Until
+ *  Bind_All is called each kernel is bound to its scalar variant, so it is always
+ *  safe to call.
+ */
+class CPUDispatchClass
+{
+    public:
+        static void Bind_All();
+
+        static void Force_Tier(CPUTierType tier) { ForcedTier = tier; }
+        static bool Is_Tier_Forced() { return ForcedTier != CPU_TIER_NONE; }
+
+        static CPUTierType Supported_Tier();
+        static CPUTierType Active_Tier();
+
+        static CPUTierType Tier_From_Name(const char *name);
+        static const char *Name_From_Tier(CPUTierType tier);
+
+        const char *Name() const { return KernelName; }
+        CPUTierType Bound_Tier() const { return BoundTier; }
+
+    protected:
+        CPUDispatchClass(const char *name, void *scalar, void *sse2, void *ssse3, void *avx2);
+
+        /**
+         *  Compares the output of the variant for this tier against the scalar reference.
+         */
+        virtual bool Test_Variant(CPUTierType tier) const = 0;
+
+        void Bind(CPUTierType max_tier);
+
+    protected:
+        const char *KernelName;
+
+        /**
+         *  The available implementations, indexed by tier. Only the scalar entry is mandatory.
+         */
+        void *Variants[CPU_TIER_COUNT];
+
+        /**
+         *  The implementation currently in use.
+         */
+        void *Bound;
+        CPUTierType BoundTier;
+
+    private:
+        /**
+         *  Intrusive list of all the registered kernels. This is built during
+         *  static initialisation so it can not rely on any allocated containers.
+         */
+        CPUDispatchClass *Next;
+
+        static CPUDispatchClass *Head;
+
+        /**
+         *  The highest tier allowed by the user, if set.
+         */
+        static CPUTierType ForcedTier;
+};
+
+
+/**
+ *  Typed wrapper for a dispatchable routine.
+ * 
+ *  The self test function is given the scalar reference and the variant under
+ *  test, and should return true if they produce matching results.
+ */
+template<typename FUNC>
+class CPUDispatchKernel : public CPUDispatchClass
+{
+    public:
+        typedef bool (*SelfTestFuncType)(FUNC reference, FUNC variant);
+
+        CPUDispatchKernel(const char *name, FUNC scalar, FUNC sse2, FUNC ssse3, FUNC avx2, SelfTestFuncType self_test = nullptr) :
+            CPUDispatchClass(name, (void *)scalar, (void *)sse2, (void *)ssse3, (void *)avx2),
+            SelfTest(self_test)
+        {
+        }
+
+        FUNC Get() const { return (FUNC)Bound; }
+        operator FUNC () const { return Get(); }
+
+    protected:
+        virtual bool Test_Variant(CPUTierType tier) const override
+        {
+            if (!SelfTest) {
+                return true;
+            }
+            return SelfTest((FUNC)Variants[CPU_TIER_SCALAR], (FUNC)Variants[tier]);
+        }
+
+    private:
+        SelfTestFuncType SelfTest;
+};
@@ -81,6 +81,7 @@ int SHA::Result(void * result) const
 {
     if (IsCached) {
         std::memcpy(result, &FinalResult, sizeof(FinalResult));
+        return sizeof(FinalResult);
     }
 
     long length = Length + PartialCount;
@@ -129,22 +130,39 @@ void SHA::Process_Block(void const * source, SHADigest & acc) const
         block[index] = _rotl(block[index-3] ^ block[index-8] ^ block[index-14] ^ block[index-16], 1);
     }
 
-    SHADigest alt = acc;
-    for (index = 0; index < PROC_BLOCK_SIZE/sizeof(long); index++) {
-        long temp = _rotl(alt.Long[0], 5) +
-                        Do_Function(index, alt.Long[1], alt.Long[2], alt.Long[3]) +
-                        alt.Long[4] + block[index] + Get_Constant(index);
-        alt.Long[4] = alt.Long[3];
-        alt.Long[3] = alt.Long[2];
-        alt.Long[2] = _rotl(alt.Long[1], 30);
-        alt.Long[1] = alt.Long[0];
-        alt.Long[0] = temp;
+    /**
+     *  The rounds are split into their four groups of twenty so the round
+     *  function and constant are fixed for each loop, and the working
+     *  variables are kept in locals rather than rotated through the digest.
+     */
+    long a = acc.Long[0];
+    long b = acc.Long[1];
+    long c = acc.Long[2];
+    long d = acc.Long[3];
+    long e = acc.Long[4];
+
+#define SHA_ROUND(func, constant) \
+    { \
+        long temp = _rotl(a, 5) + func(b, c, d) + e + block[index] + (long)constant; \
+        e = d; \
+        d = c; \
+        c = _rotl(b, 30); \
+        b = a; \
+        a = temp; \
     }
-    acc.Long[0] += alt.Long[0];
-    acc.Long[1] += alt.Long[1];
-    acc.Long[2] += alt.Long[2];
-    acc.Long[3] += alt.Long[3];
-    acc.Long[4] += alt.Long[4];
+
+    for (index = 0; index < 20; index++) SHA_ROUND(Function1, K1);
+    for (; index < 40; index++) SHA_ROUND(Function2, K2);
+    for (; index < 60; index++) SHA_ROUND(Function3, K3);
+    for (; index < 80; index++) SHA_ROUND(Function4, K4);
+
+#undef SHA_ROUND
+
+    acc.Long[0] += a;
+    acc.Long[1] += b;
+    acc.Long[2] += c;
+    acc.Long[3] += d;
+    acc.Long[4] += e;
 }
 
 
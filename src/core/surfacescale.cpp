@@ -28,15 +28,789 @@
 #include "surfacescale.h"
 #include "vinifera_util.h"
 #include "xsurface.h"
+#include "cpudispatch.h"
 #include "vnImagine.h"
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <emmintrin.h>
+#include <immintrin.h>
 
 
 /**
- *  The scaling is performed with the use of the Image-Resampler library;
+ *  Nearest and bilinear scaling is performed directly on the surface memory
+ *  using precomputed coefficient tables. The higher quality filters are performed
+ *  with the use of the Image-Resampler library;
  *  https://github.com/ramenhut/image-resampler
  */
 
 
+/**
+ *  Fixed point precision of the interpolation weights. This is limited to 15 bits
+ *  so the SIMD variants can use a signed 16-bit multiply.
+ */
+#define SCALE_FRAC_BITS 15
+#define SCALE_FRAC_ONE (1 << SCALE_FRAC_BITS)
+
+/**
+ *  Fixed point precision of the horizontal weights. The product with an 8-bit
+ *  channel difference still fits in 32 bits.
+ */
+#define SCALE_WEIGHT_BITS 23
+#define SCALE_WEIGHT_ONE (1 << SCALE_WEIGHT_BITS)
+
+/**
+ *  How close to a whole channel value the horizontal result has to be before
+ *  the exact arithmetic of the library is used. This covers the truncated weight
+ *  and the float rounding within the library.
+ */
+#define SCALE_WEIGHT_MARGIN 1024
+
+/**
+ *  The range the Image-Resampler library widens each fixed point channel to.
+ */
+#define SCALE_WIDE_MAX 0x7FFFFFFF
+
+/**
+ *  The number of coefficient tables to keep, each scale uses two (one for each axis).
+ */
+#define SCALE_COEFF_CACHE_SIZE 16
+
+
+/**
+ *  Source sample positions for each destination pixel along one axis.
+ */
+typedef struct ScaleCoeffTableStruct
+{
+    int SrcSize;
+    int DstSize;
+
+    /**
+     *  The nearest source pixel.
+     */
+    int *Nearest;
+
+    /**
+     *  The two source pixels to interpolate between and the weight of the second.
+     */
+    int *Index0;
+    int *Index1;
+    int *Frac;
+
+    /**
+     *  The weight of the second pixel as the library computes it, and in fixed point.
+     */
+    float *Weight;
+    int *WeightFixed;
+} ScaleCoeffTableStruct;
+
+static ScaleCoeffTableStruct ScaleCoeffCache[SCALE_COEFF_CACHE_SIZE];
+static int ScaleCoeffCacheNext = 0;
+
+/**
+ *  Scratch rows for the horizontal pass of the bilinear filter.
+ */
+static unsigned char *ScaleRowBuffer = nullptr;
+static int ScaleRowBufferSize = 0;
+
+
+/**
+ *  Fills in the coefficient table for scaling between the two sizes.
+ * 
+ *  The sample positions match those used by the Image-Resampler library, so the
+ *  first and last pixels of the source map onto the first and last pixels of
+ *  the destination.
+ *
+ *  @author: CCHyper
+ */
+static void Build_Coeff_Table(ScaleCoeffTableStruct &table, int src_size, int dst_size)
+{
+    delete [] table.Nearest;
+    delete [] table.Weight;
+
+    table.SrcSize = src_size;
+    table.DstSize = dst_size;
+    table.Nearest = new int [dst_size * 5];
+    table.Index0 = table.Nearest + dst_size;
+    table.Index1 = table.Index0 + dst_size;
+    table.Frac = table.Index1 + dst_size;
+    table.WeightFixed = table.Frac + dst_size;
+    table.Weight = new float [dst_size];
+
+    float ratio = (dst_size == 1) ? 1.0f : (float)(src_size - 1) / (float)(dst_size - 1);
+
+    for (int i = 0; i < dst_size; ++i) {
+
+        float pos = (float)i * ratio;
+        int index = (int)pos;
+
+        float weight = pos - (float)index;
+
+        int frac = (int)(weight * SCALE_FRAC_ONE);
+        frac = std::clamp(frac, 0, SCALE_FRAC_ONE-1);
+
+        table.Nearest[i] = std::clamp((int)(pos + 0.5f), 0, src_size-1);
+        table.Index0[i] = std::clamp(index, 0, src_size-1);
+        table.Index1[i] = std::clamp(index+1, 0, src_size-1);
+        table.Frac[i] = frac;
+        table.Weight[i] = weight;
+        table.WeightFixed[i] = std::clamp((int)(weight * SCALE_WEIGHT_ONE), 0, SCALE_WEIGHT_ONE-1);
+    }
+}
+
+
+/**
+ *  Fetches the coefficient table for the size pair, building it if required.
+ * 
+ *  @warning: The table passed as "keep" will not be evicted to make room.
+ *
+ *  @author: CCHyper
+ */
+static const ScaleCoeffTableStruct &Get_Coeff_Table(int src_size, int dst_size, const ScaleCoeffTableStruct *keep = nullptr)
+{
+    for (int i = 0; i < SCALE_COEFF_CACHE_SIZE; ++i) {
+        ScaleCoeffTableStruct &table = ScaleCoeffCache[i];
+        if (table.Nearest && table.SrcSize == src_size && table.DstSize == dst_size) {
+            return table;
+        }
+    }
+
+    if (&ScaleCoeffCache[ScaleCoeffCacheNext] == keep) {
+        ScaleCoeffCacheNext = (ScaleCoeffCacheNext + 1) % SCALE_COEFF_CACHE_SIZE;
+    }
+
+    ScaleCoeffTableStruct &table = ScaleCoeffCache[ScaleCoeffCacheNext];
+    ScaleCoeffCacheNext = (ScaleCoeffCacheNext + 1) % SCALE_COEFF_CACHE_SIZE;
+
+    Build_Coeff_Table(table, src_size, dst_size);
+
+    return table;
+}
+
+
+/**
+ *  Interpolates a single channel for the vertical pass, following the rounding
+ *  of the Image-Resampler bilinear kernel. The library widens each channel to
+ *  31 bits and truncates when packing it back, so the result is the exact value
+ *  rounded up, minus one (zero and the channel maximum are kept). This is within
+ *  one step of the library, as its float weight is more precise and can round a
+ *  whole value back up.
+ *
+ *  @author: CCHyper
+ */
+static inline int Lerp_Channel(int a, int b, int frac, int max)
+{
+    int result = a - 1 - ((a - b) * frac >> SCALE_FRAC_BITS);
+
+    if ((a | b) == 0 || (a & b) == max) {
+        ++result;
+    }
+
+    return result;
+}
+
+
+/**
+ *  Interpolates between two pixels, see Lerp_Channel for the rounding.
+ *
+ *  @author: CCHyper
+ */
+static inline unsigned short Lerp_565(unsigned short a, unsigned short b, int frac)
+{
+    if (frac == 0) {
+        b = a;
+    }
+
+    int r = Lerp_Channel((a >> 11), (b >> 11), frac, 0x1F);
+    int g = Lerp_Channel((a >> 5) & 0x3F, (b >> 5) & 0x3F, frac, 0x3F);
+    int bl = Lerp_Channel((a & 0x1F), (b & 0x1F), frac, 0x1F);
+
+    return (unsigned short)((r << 11) | (g << 5) | bl);
+}
+
+static inline unsigned Lerp_8888(unsigned a, unsigned b, int frac)
+{
+    if (frac == 0) {
+        b = a;
+    }
+
+    unsigned result = 0;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= (unsigned)Lerp_Channel((a >> shift) & 0xFF, (b >> shift) & 0xFF, frac, 0xFF) << shift;
+    }
+
+    return result;
+}
+
+
+/**
+ *  Interpolates a single channel with the arithmetic of the Image-Resampler
+ *  bilinear kernel. The library widens each channel to 31 bits, interpolates
+ *  and then truncates the result when packing it back.
+ *
+ *  @author: CCHyper
+ */
+static inline int Resample_Channel_Exact(int a, int b, float weight, int max)
+{
+    long long wide_a = (long long)SCALE_WIDE_MAX * a / max;
+    long long wide_b = (long long)SCALE_WIDE_MAX * b / max;
+
+    /**
+     *  The library multiplies the second channel in single precision.
+     */
+    long long wide = (long long)((double)wide_a * (1.0 - weight) + (float)wide_b * weight);
+    wide = std::clamp(wide, 0LL, (long long)SCALE_WIDE_MAX);
+
+    return (int)(max * wide / SCALE_WIDE_MAX);
+}
+
+
+/**
+ *  Interpolates a single channel for the horizontal pass in fixed point, the
+ *  result is the exact value rounded down. This matches the library unless the
+ *  exact value is close to a whole value, where the float arithmetic of the
+ *  library decides which side the result falls on. Those are flagged in "exact".
+ *
+ *  @author: CCHyper
+ */
+static inline int Resample_Channel(int a, int b, int weight_fixed, bool &exact)
+{
+    int value = (a << SCALE_WEIGHT_BITS) + (b - a) * weight_fixed;
+
+    exact |= (((value + SCALE_WEIGHT_MARGIN) & (SCALE_WEIGHT_ONE-1)) <= SCALE_WEIGHT_MARGIN*2);
+
+    return value >> SCALE_WEIGHT_BITS;
+}
+
+
+/**
+ *  Interpolates between two pixels for the horizontal pass, the result is identical
+ *  to the Image-Resampler bilinear kernel. The vertical pass then only adds its
+ *  own rounding difference.
+ *
+ *  @author: CCHyper
+ */
+static unsigned short Resample_565_Exact(unsigned short a, unsigned short b, float weight)
+{
+    int r = Resample_Channel_Exact((a >> 11), (b >> 11), weight, 0x1F);
+    int g = Resample_Channel_Exact((a >> 5) & 0x3F, (b >> 5) & 0x3F, weight, 0x3F);
+    int bl = Resample_Channel_Exact((a & 0x1F), (b & 0x1F), weight, 0x1F);
+
+    return (unsigned short)((r << 11) | (g << 5) | bl);
+}
+
+static inline unsigned short Resample_565(unsigned short a, unsigned short b, float weight, int weight_fixed)
+{
+    /**
+     *  Matching pixels always land on a whole value, these are common in 16-bit art.
+     */
+    if (a == b) {
+        return Resample_565_Exact(a, b, weight);
+    }
+
+    bool exact = false;
+
+    int r = Resample_Channel((a >> 11), (b >> 11), weight_fixed, exact);
+    int g = Resample_Channel((a >> 5) & 0x3F, (b >> 5) & 0x3F, weight_fixed, exact);
+    int bl = Resample_Channel((a & 0x1F), (b & 0x1F), weight_fixed, exact);
+
+    if (exact) {
+        return Resample_565_Exact(a, b, weight);
+    }
+
+    return (unsigned short)((r << 11) | (g << 5) | bl);
+}
+
+static unsigned Resample_8888_Exact(unsigned a, unsigned b, float weight)
+{
+    unsigned result = 0;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= (unsigned)Resample_Channel_Exact((a >> shift) & 0xFF, (b >> shift) & 0xFF, weight, 0xFF) << shift;
+    }
+
+    return result;
+}
+
+static inline unsigned Resample_8888(unsigned a, unsigned b, float weight, int weight_fixed)
+{
+    bool exact = false;
+    unsigned result = 0;
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= (unsigned)Resample_Channel((a >> shift) & 0xFF, (b >> shift) & 0xFF, weight_fixed, exact) << shift;
+    }
+
+    if (exact) {
+        return Resample_8888_Exact(a, b, weight);
+    }
+
+    return result;
+}
+
+
+/**
+ *  Blends two rows of pixels with a single weight, this is the vertical pass
+ *  of the bilinear filter.
+ */
+typedef void (*BlendRowFuncType)(const void *row0, const void *row1, void *dst, int count, int frac);
+
+static void Blend_Row_565_Scalar(const void *row0, const void *row1, void *dst, int count, int frac)
+{
+    const unsigned short *a = (const unsigned short *)row0;
+    const unsigned short *b = (const unsigned short *)row1;
+    unsigned short *d = (unsigned short *)dst;
+
+    for (int i = 0; i < count; ++i) {
+        d[i] = Lerp_565(a[i], b[i], frac);
+    }
+}
+
+static void Blend_Row_8888_Scalar(const void *row0, const void *row1, void *dst, int count, int frac)
+{
+    const unsigned *a = (const unsigned *)row0;
+    const unsigned *b = (const unsigned *)row1;
+    unsigned *d = (unsigned *)dst;
+
+    for (int i = 0; i < count; ++i) {
+        d[i] = Lerp_8888(a[i], b[i], frac);
+    }
+}
+
+
+/**
+ *  SIMD versions of the row blend. The channel difference is doubled before
+ *  the high multiply so the product is (difference * frac) >> 15, the rounding
+ *  then follows Lerp_Channel, exactly matching the scalar reference.
+ *
+ *  @author: CCHyper
+ */
+static inline __m128i Lerp_Channel_SSE2(__m128i a, __m128i b, __m128i weight, __m128i max)
+{
+    __m128i result = _mm_sub_epi16(a, _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(a, b), 1), weight));
+    result = _mm_sub_epi16(result, _mm_set1_epi16(1));
+    result = _mm_sub_epi16(result, _mm_cmpeq_epi16(_mm_or_si128(a, b), _mm_setzero_si128()));
+    result = _mm_sub_epi16(result, _mm_cmpeq_epi16(_mm_and_si128(a, b), max));
+    return result;
+}
+
+static inline __m256i Lerp_Channel_AVX2(__m256i a, __m256i b, __m256i weight, __m256i max)
+{
+    __m256i result = _mm256_sub_epi16(a, _mm256_mulhi_epi16(_mm256_slli_epi16(_mm256_sub_epi16(a, b), 1), weight));
+    result = _mm256_sub_epi16(result, _mm256_set1_epi16(1));
+    result = _mm256_sub_epi16(result, _mm256_cmpeq_epi16(_mm256_or_si256(a, b), _mm256_setzero_si256()));
+    result = _mm256_sub_epi16(result, _mm256_cmpeq_epi16(_mm256_and_si256(a, b), max));
+    return result;
+}
+
+static void Blend_Row_565_SSE2(const void *row0, const void *row1, void *dst, int count, int frac)
+{
+    if (frac == 0) {
+        row1 = row0;
+    }
+
+    const unsigned short *a = (const unsigned short *)row0;
+    const unsigned short *b = (const unsigned short *)row1;
+    unsigned short *d = (unsigned short *)dst;
+
+    const __m128i weight = _mm_set1_epi16((short)frac);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m128i pa = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i pb = _mm_loadu_si128((const __m128i *)(b + i));
+
+        __m128i ra = _mm_srli_epi16(pa, 11);
+        __m128i ga = _mm_and_si128(_mm_srli_epi16(pa, 5), mask6);
+        __m128i ba = _mm_and_si128(pa, mask5);
+
+        __m128i rb = _mm_srli_epi16(pb, 11);
+        __m128i gb = _mm_and_si128(_mm_srli_epi16(pb, 5), mask6);
+        __m128i bb = _mm_and_si128(pb, mask5);
+
+        __m128i r = Lerp_Channel_SSE2(ra, rb, weight, mask5);
+        __m128i g = Lerp_Channel_SSE2(ga, gb, weight, mask6);
+        __m128i bl = Lerp_Channel_SSE2(ba, bb, weight, mask5);
+
+        __m128i out = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), bl);
+        _mm_storeu_si128((__m128i *)(d + i), out);
+    }
+
+    for (; i < count; ++i) {
+        d[i] = Lerp_565(a[i], b[i], frac);
+    }
+}
+
+static void Blend_Row_8888_SSE2(const void *row0, const void *row1, void *dst, int count, int frac)
+{
+    if (frac == 0) {
+        row1 = row0;
+    }
+
+    const unsigned *a = (const unsigned *)row0;
+    const unsigned *b = (const unsigned *)row1;
+    unsigned *d = (unsigned *)dst;
+
+    const __m128i weight = _mm_set1_epi16((short)frac);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask8 = _mm_set1_epi16(0xFF);
+
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i pa = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i pb = _mm_loadu_si128((const __m128i *)(b + i));
+
+        __m128i alo = _mm_unpacklo_epi8(pa, zero);
+        __m128i ahi = _mm_unpackhi_epi8(pa, zero);
+        __m128i blo = _mm_unpacklo_epi8(pb, zero);
+        __m128i bhi = _mm_unpackhi_epi8(pb, zero);
+
+        __m128i lo = Lerp_Channel_SSE2(alo, blo, weight, mask8);
+        __m128i hi = Lerp_Channel_SSE2(ahi, bhi, weight, mask8);
+
+        _mm_storeu_si128((__m128i *)(d + i), _mm_packus_epi16(lo, hi));
+    }
+
+    for (; i < count; ++i) {
+        d[i] = Lerp_8888(a[i], b[i], frac);
+    }
+}
+
+static void Blend_Row_565_AVX2(const void *row0, const void *row1, void *dst, int count, int frac)
+{
+    if (frac == 0) {
+        row1 = row0;
+    }
+
+    const unsigned short *a = (const unsigned short *)row0;
+    const unsigned short *b = (const unsigned short *)row1;
+    unsigned short *d = (unsigned short *)dst;
+
+    const __m256i weight = _mm256_set1_epi16((short)frac);
+    const __m256i mask6 = _mm256_set1_epi16(0x3F);
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+
+    int i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i pa = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i pb = _mm256_loadu_si256((const __m256i *)(b + i));
+
+        __m256i ra = _mm256_srli_epi16(pa, 11);
+        __m256i ga = _mm256_and_si256(_mm256_srli_epi16(pa, 5), mask6);
+        __m256i ba = _mm256_and_si256(pa, mask5);
+
+        __m256i rb = _mm256_srli_epi16(pb, 11);
+        __m256i gb = _mm256_and_si256(_mm256_srli_epi16(pb, 5), mask6);
+        __m256i bb = _mm256_and_si256(pb, mask5);
+
+        __m256i r = Lerp_Channel_AVX2(ra, rb, weight, mask5);
+        __m256i g = Lerp_Channel_AVX2(ga, gb, weight, mask6);
+        __m256i bl = Lerp_Channel_AVX2(ba, bb, weight, mask5);
+
+        __m256i out = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), bl);
+        _mm256_storeu_si256((__m256i *)(d + i), out);
+    }
+
+    _mm256_zeroupper();
+
+    for (; i < count; ++i) {
+        d[i] = Lerp_565(a[i], b[i], frac);
+    }
+}
+
+static void Blend_Row_8888_AVX2(const void *row0, const void *row1, void *dst, int count, int frac)
+{
+    if (frac == 0) {
+        row1 = row0;
+    }
+
+    const unsigned *a = (const unsigned *)row0;
+    const unsigned *b = (const unsigned *)row1;
+    unsigned *d = (unsigned *)dst;
+
+    const __m256i weight = _mm256_set1_epi16((short)frac);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask8 = _mm256_set1_epi16(0xFF);
+
+    int i = 0;
+
+    /**
+     *  The unpack and pack instructions both work within each 128-bit lane,
+     *  so the pixel order is preserved.
+     */
+    for (; i + 8 <= count; i += 8) {
+        __m256i pa = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i pb = _mm256_loadu_si256((const __m256i *)(b + i));
+
+        __m256i alo = _mm256_unpacklo_epi8(pa, zero);
+        __m256i ahi = _mm256_unpackhi_epi8(pa, zero);
+        __m256i blo = _mm256_unpacklo_epi8(pb, zero);
+        __m256i bhi = _mm256_unpackhi_epi8(pb, zero);
+
+        __m256i lo = Lerp_Channel_AVX2(alo, blo, weight, mask8);
+        __m256i hi = Lerp_Channel_AVX2(ahi, bhi, weight, mask8);
+
+        _mm256_storeu_si256((__m256i *)(d + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    _mm256_zeroupper();
+
+    for (; i < count; ++i) {
+        d[i] = Lerp_8888(a[i], b[i], frac);
+    }
+}
+
+
+/**
+ *  Checks a row blend variant against the scalar reference, including the
+ *  remainder pixels that do not fill a full register.
+ *
+ *  @author: CCHyper
+ */
+static bool Blend_Row_Self_Test(BlendRowFuncType reference, BlendRowFuncType variant, int bytes_per_pixel)
+{
+    static const int count = 67;
+    static const int fracs[] = { 0, 1, SCALE_FRAC_ONE/3, SCALE_FRAC_ONE/2, SCALE_FRAC_ONE-1 };
+
+    unsigned char row0[count * 4];
+    unsigned char row1[count * 4];
+    unsigned char expected[count * 4];
+    unsigned char result[count * 4];
+
+    unsigned seed = 0x1234567;
+    for (int i = 0; i < count * 4; ++i) {
+        seed = seed * 1103515245 + 12345;
+        row0[i] = (unsigned char)(seed >> 16);
+        seed = seed * 1103515245 + 12345;
+        row1[i] = (unsigned char)(seed >> 16);
+    }
+
+    for (int i = 0; i < std::size(fracs); ++i) {
+        reference(row0, row1, expected, count, fracs[i]);
+        variant(row0, row1, result, count, fracs[i]);
+        if (std::memcmp(expected, result, count * bytes_per_pixel) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool Blend_Row_565_Self_Test(BlendRowFuncType reference, BlendRowFuncType variant)
+{
+    return Blend_Row_Self_Test(reference, variant, 2);
+}
+
+static bool Blend_Row_8888_Self_Test(BlendRowFuncType reference, BlendRowFuncType variant)
+{
+    return Blend_Row_Self_Test(reference, variant, 4);
+}
+
+static CPUDispatchKernel<BlendRowFuncType> Blend_Row_565("Blend_Row_565",
+    &Blend_Row_565_Scalar, &Blend_Row_565_SSE2, nullptr, &Blend_Row_565_AVX2, &Blend_Row_565_Self_Test);
+
+static CPUDispatchKernel<BlendRowFuncType> Blend_Row_8888("Blend_Row_8888",
+    &Blend_Row_8888_Scalar, &Blend_Row_8888_SSE2, nullptr, &Blend_Row_8888_AVX2, &Blend_Row_8888_Self_Test);
+
+
+/**
+ *  Resamples a single source row to the destination width, this is the horizontal
+ *  pass of the bilinear filter.
+ *
+ *  @author: CCHyper
+ */
+static void Resample_Row(const unsigned char *src, unsigned char *dst, const ScaleCoeffTableStruct &xtab, int bytes_per_pixel)
+{
+    if (bytes_per_pixel == 2) {
+        const unsigned short *s = (const unsigned short *)src;
+        unsigned short *d = (unsigned short *)dst;
+        for (int i = 0; i < xtab.DstSize; ++i) {
+            d[i] = Resample_565(s[xtab.Index0[i]], s[xtab.Index1[i]], xtab.Weight[i], xtab.WeightFixed[i]);
+        }
+
+    } else {
+        const unsigned *s = (const unsigned *)src;
+        unsigned *d = (unsigned *)dst;
+        for (int i = 0; i < xtab.DstSize; ++i) {
+            d[i] = Resample_8888(s[xtab.Index0[i]], s[xtab.Index1[i]], xtab.Weight[i], xtab.WeightFixed[i]);
+        }
+    }
+}
+
+
+/**
+ *  Scales the source buffer into the destination buffer by picking the nearest pixel.
+ *
+ *  @author: CCHyper
+ */
+static void Scale_Buffer_Nearest(const unsigned char *src, int src_pitch, unsigned char *dst, int dst_pitch,
+    const ScaleCoeffTableStruct &xtab, const ScaleCoeffTableStruct &ytab, int bytes_per_pixel)
+{
+    int prev_row = -1;
+
+    for (int y = 0; y < ytab.DstSize; ++y) {
+
+        unsigned char *dst_row = dst + (y * dst_pitch);
+        int src_row = ytab.Nearest[y];
+
+        /**
+         *  When upscaling, consecutive rows often sample the same source row.
+         */
+        if (src_row == prev_row) {
+            std::memcpy(dst_row, dst_row - dst_pitch, xtab.DstSize * bytes_per_pixel);
+            continue;
+        }
+
+        prev_row = src_row;
+
+        if (bytes_per_pixel == 2) {
+            const unsigned short *s = (const unsigned short *)(src + (src_row * src_pitch));
+            unsigned short *d = (unsigned short *)dst_row;
+            for (int x = 0; x < xtab.DstSize; ++x) {
+                d[x] = s[xtab.Nearest[x]];
+            }
+
+        } else {
+            const unsigned *s = (const unsigned *)(src + (src_row * src_pitch));
+            unsigned *d = (unsigned *)dst_row;
+            for (int x = 0; x < xtab.DstSize; ++x) {
+                d[x] = s[xtab.Nearest[x]];
+            }
+        }
+    }
+}
+
+
+/**
+ *  Scales the source buffer into the destination buffer with bilinear filtering.
+ * 
+ *  Only the two source rows needed for the current destination row are resampled
+ *  horizontally, these are then blended into the destination.
+ *
+ *  @author: CCHyper
+ */
+static void Scale_Buffer_Bilinear(const unsigned char *src, int src_pitch, unsigned char *dst, int dst_pitch,
+    const ScaleCoeffTableStruct &xtab, const ScaleCoeffTableStruct &ytab, int bytes_per_pixel)
+{
+    int row_size = xtab.DstSize * bytes_per_pixel;
+
+    /**
+     *  The library only copies the image when neither dimension changes.
+     */
+    if (xtab.SrcSize == xtab.DstSize && ytab.SrcSize == ytab.DstSize) {
+        for (int y = 0; y < ytab.DstSize; ++y) {
+            std::memcpy(dst + (y * dst_pitch), src + (y * src_pitch), row_size);
+        }
+        return;
+    }
+
+    if (ScaleRowBufferSize < row_size * 2) {
+        delete [] ScaleRowBuffer;
+        ScaleRowBuffer = new unsigned char [row_size * 2];
+        ScaleRowBufferSize = row_size * 2;
+    }
+
+    unsigned char *rows[2] = { ScaleRowBuffer, ScaleRowBuffer + row_size };
+    int row_index[2] = { -1, -1 };
+
+    BlendRowFuncType blend = (bytes_per_pixel == 2) ? Blend_Row_565.Get() : Blend_Row_8888.Get();
+
+    for (int y = 0; y < ytab.DstSize; ++y) {
+
+        unsigned char *dst_row = dst + (y * dst_pitch);
+        int src_row0 = ytab.Index0[y];
+        int src_row1 = ytab.Index1[y];
+        int frac = ytab.Frac[y];
+
+        /**
+         *  Moving down the image, the previous second row usually becomes the first.
+         */
+        if (row_index[0] != src_row0) {
+            if (row_index[1] == src_row0) {
+                std::swap(rows[0], rows[1]);
+                std::swap(row_index[0], row_index[1]);
+            } else {
+                Resample_Row(src + (src_row0 * src_pitch), rows[0], xtab, bytes_per_pixel);
+                row_index[0] = src_row0;
+            }
+        }
+
+        /**
+         *  The library still passes these rows through the kernel, see Lerp_Channel.
+         */
+        if (frac == 0) {
+            blend(rows[0], rows[0], dst_row, xtab.DstSize, 0);
+            continue;
+        }
+
+        if (row_index[1] != src_row1) {
+            Resample_Row(src + (src_row1 * src_pitch), rows[1], xtab, bytes_per_pixel);
+            row_index[1] = src_row1;
+        }
+
+        blend(rows[0], rows[1], dst_row, xtab.DstSize, frac);
+    }
+}
+
+
+/** 
+ *  Scales an input surface to fit the destination surface without any intermediate images.
+ * 
+ *  @author: CCHyper
+ */
+static bool Scale_Surface_Direct(XSurface *src, XSurface *dst, bool bilinear)
+{
+    if (!src || !dst || src == dst) {
+        return false;
+    }
+
+    int src_width = src->Get_Width();
+    int src_height = src->Get_Height();
+    int src_bpp = src->Get_Bytes_Per_Pixel();
+
+    int dst_width = dst->Get_Width();
+    int dst_height = dst->Get_Height();
+    int dst_bpp = dst->Get_Bytes_Per_Pixel();
+
+    if (src_bpp != dst_bpp || (src_bpp != 2 && src_bpp != 4)) {
+        return false;
+    }
+
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        return false;
+    }
+
+    unsigned char *src_buff = (unsigned char *)src->Lock();
+    unsigned char *dst_buff = (unsigned char *)dst->Lock();
+
+    if (!src_buff || !dst_buff) {
+        src->Unlock();
+        dst->Unlock();
+        return false;
+    }
+
+    const ScaleCoeffTableStruct &xtab = Get_Coeff_Table(src_width, dst_width);
+    const ScaleCoeffTableStruct &ytab = Get_Coeff_Table(src_height, dst_height, &xtab);
+
+    if (bilinear) {
+        Scale_Buffer_Bilinear(src_buff, src->Get_Pitch(), dst_buff, dst->Get_Pitch(), xtab, ytab, src_bpp);
+    } else {
+        Scale_Buffer_Nearest(src_buff, src->Get_Pitch(), dst_buff, dst->Get_Pitch(), xtab, ytab, src_bpp);
+    }
+
+    src->Unlock();
+    dst->Unlock();
+
+    return true;
+}
+
+
 /** 
  *  Scales an input surface to fit the destination surface using the Image-Resampler library.
  * 
@@ -56,7 +830,7 @@ static bool Scale_Surface_ImageResampler(XSurface *src, XSurface *dst, VN_IMAGE_
     int dst_height = dst->Get_Height();
     int dst_bpp = dst->Get_Bytes_Per_Pixel();
 
-    if (src_bpp != 2 || dst_bpp != 2) {
+    if (src_bpp != dst_bpp || (src_bpp != 2 && src_bpp != 4)) {
         return false;
     }
 
@@ -72,31 +846,41 @@ static bool Scale_Surface_ImageResampler(XSurface *src, XSurface *dst, VN_IMAGE_
     CVImage source_image;
     CVImage resampled_image;
 
-    VN_IMAGE_FORMAT format = VN_IMAGE_FORMAT_R5G6B5; // 16-bit RGB
+    VN_IMAGE_FORMAT format = (src_bpp == 2) ? VN_IMAGE_FORMAT_R5G6B5 : VN_IMAGE_FORMAT_R8G8B8A8;
 
     /**
      *  Create a new image buffer, this will be where the source image data will be stored.
      */
     if (VN_FAILED(vnCreateImage(format, src_width, src_height, &source_image))) {
+        src->Unlock();
+        dst->Unlock();
         return false;
     }
 
     /**
-     *  Copy the source image data into the new image buffer.
+     *  Copy the source image data into the new image buffer, the surface rows may be padded.
      */
-    std::memcpy(source_image.QueryData(), src_buff, src_width*src_height*src_bpp);
+    int src_pitch = src->Get_Pitch();
+    for (int y = 0; y < src_height; ++y) {
+        std::memcpy(source_image.QueryData() + (y * src_width * src_bpp), src_buff + (y * src_pitch), src_width * src_bpp);
+    }
     
     /**
      *  Resize the source image to fit the destination surface.
      */
     if (VN_FAILED(vnResizeImage(source_image, kernel, dst_width, dst_height, 0, &resampled_image))) {
+        src->Unlock();
+        dst->Unlock();
         return false;
     }
     
     /**
      *  Now copy the resized image data back into the destination surface.
      */
-    std::memcpy(dst_buff, resampled_image.QueryData(), dst_width*dst_height*dst_bpp);
+    int dst_pitch = dst->Get_Pitch();
+    for (int y = 0; y < dst_height; ++y) {
+        std::memcpy(dst_buff + (y * dst_pitch), resampled_image.QueryData() + (y * dst_width * dst_bpp), dst_width * dst_bpp);
+    }
 
     src->Unlock();
     dst->Unlock();
@@ -112,12 +896,12 @@ static bool Scale_Surface_ImageResampler(XSurface *src, XSurface *dst, VN_IMAGE_
  */
 bool Scale_Surface_Nearest(XSurface *src, XSurface *dst)
 {
-    return Scale_Surface_ImageResampler(src, dst, VN_IMAGE_KERNEL_NEAREST);
+    return Scale_Surface_Direct(src, dst, false);
 }
 
 bool Scale_Surface_Bilinear(XSurface *src, XSurface *dst)
 {
-    return Scale_Surface_ImageResampler(src, dst, VN_IMAGE_KERNEL_BILINEAR);
+    return Scale_Surface_Direct(src, dst, true);
 }
 
 bool Scale_Surface_Bicubic(XSurface *src, XSurface *dst)
@@ -41,13 +41,39 @@
 #define STACK_DEPTH_MAX 30
 
 
+/**
+ *  Size of the address to symbol cache, must be a power of two.
+ */
+#define STACK_SYMBOL_CACHE_SIZE 256
+
+
 /**
  *  Strip the full path from the source name in the debug info?
  */
 static bool StripFilenamePaths = true;
 
+/**
+ *  Skip symbol lookups and write the module relative address of each frame
+ *  to a separate file instead, for symbolizing offline against the map or PDB file.
+ */
+static bool RawStackDumps = false;
+static char RawStackDumpFilename[PATH_MAX];
+
 
-static void Get_Function_Details(void *pointer, char *funcname, char *filename, unsigned *linenumber, uintptr_t *address)
+/**
+ *  Cache of formatted stack lines, shared between all stack dumps so a
+ *  repeated assert or exception does not perform the symbol lookups again.
+ */
+typedef struct StackSymbolCacheStruct
+{
+    uintptr_t Address;
+    char Line[PATH_MAX];
+} StackSymbolCacheStruct;
+
+static StackSymbolCacheStruct StackSymbolCache[STACK_SYMBOL_CACHE_SIZE];
+
+
+static bool Get_Function_Details(void *pointer, char *funcname, char *filename, unsigned *linenumber, uintptr_t *address)
 {
     char symbol_buffer[sizeof(IMAGEHLP_SYMBOL64) + STACK_SYMNAME_MAX];
     IMAGEHLP_SYMBOL64 *const symbol_bufferp = reinterpret_cast<IMAGEHLP_SYMBOL64 *>(symbol_buffer);
@@ -145,6 +171,8 @@ static void Get_Function_Details(void *pointer, char *funcname, char *filename,
             //DEBUG_INFO("Get_Function_Details() - SymFromAddr failed: %d\n", GetLastError());
         }
     //}
+
+    return got_it != FALSE;
 }
 
 
@@ -157,25 +185,124 @@ static void Write_Stack_Line(void *address, stackcallback_ptr_t callback)
     uintptr_t addr;
     unsigned line;
 
+    StackSymbolCacheStruct &entry = StackSymbolCache[((uintptr_t)address >> 2) & (STACK_SYMBOL_CACHE_SIZE-1)];
+
+    /**
+     *  Only look up the symbol if this address is not already cached.
+     */
+    if (entry.Address != (uintptr_t)address) {
+
+        bool found = Get_Function_Details(address, funcname, filename, &line, &addr);
+
+        std::snprintf(dest, sizeof(dest), "  %s(%d) : %s 0x%" PRIPTRSIZE PRIXPTR "\r\n", filename, line, funcname, (uintptr_t)address);
+
+        /**
+         *  Failed lookups are not cached, the symbols for the module might
+         *  not have been loaded yet.
+         */
+        if (!found) {
+            if (callback != nullptr) {
+                callback(dest);
+            }
+            return;
+        }
+
+        std::strcpy(entry.Line, dest);
+        entry.Address = (uintptr_t)address;
+    }
+
+    if (callback != nullptr) {
+        callback(entry.Line);
+    }
+}
+
+
+/**
+ *  Appends the frames of a stack dump to the raw stack dump file. Each module
+ *  is listed once with its base address, followed by one line per frame with
+ *  the module index and the offset into it.
+ */
+static bool Write_Raw_Stack(void **addresses, int address_count)
+{
+    char buffer[PATH_MAX+64];
     char pathname[PATH_MAX+1];
-    char path[PATH_MAX];
     char name[_MAX_FNAME];
     char ext[_MAX_EXT];
+    DWORD written;
+
+    HMODULE modules[STACK_DEPTH_MAX];
+    int frame_module[STACK_DEPTH_MAX];
+    int module_count = 0;
+
+    HANDLE file = CreateFileA(RawStackDumpFilename, FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
 
     /**
-     *  Get the module name, removing the full path.
+     *  Find the module each frame belongs to.
      */
-    //GetModuleFileNameA(nullptr, pathname, PATH_MAX);
-    //_splitpath(pathname, nullptr, nullptr, name, ext);
-    //_makepath(path, nullptr, nullptr, name, ext);
+    for (int i = 0; i < address_count; ++i) {
+        HMODULE module = nullptr;
 
-    Get_Function_Details(address, funcname, filename, &line, &addr);
+        frame_module[i] = -1;
 
-    //std::snprintf(dest, sizeof(dest), "  [%s] %s(%d) : %s 0x%" PRIPTRSIZE PRIXPTR "\n", path, filename, line, funcname, (uintptr_t)address);
-    std::snprintf(dest, sizeof(dest), "  %s(%d) : %s 0x%" PRIPTRSIZE PRIXPTR "\r\n", filename, line, funcname, (uintptr_t)address);
+        if (!GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS|GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)addresses[i], &module)) {
+            continue;
+        }
 
-    if (callback != nullptr) {
-        callback(dest);
+        for (int j = 0; j < module_count; ++j) {
+            if (modules[j] == module) {
+                frame_module[i] = j;
+                break;
+            }
+        }
+
+        if (frame_module[i] == -1) {
+            frame_module[i] = module_count;
+            modules[module_count++] = module;
+        }
+    }
+
+    std::snprintf(buffer, sizeof(buffer), "# %d frames\r\n", address_count);
+    WriteFile(file, buffer, (DWORD)std::strlen(buffer), &written, nullptr);
+
+    for (int i = 0; i < module_count; ++i) {
+        name[0] = '\0';
+        ext[0] = '\0';
+        if (GetModuleFileNameA(modules[i], pathname, PATH_MAX)) {
+            _splitpath(pathname, nullptr, nullptr, name, ext);
+        }
+        std::snprintf(buffer, sizeof(buffer), "M%d 0x%" PRIPTRSIZE PRIXPTR " %s%s\r\n", i, (uintptr_t)modules[i], name, ext);
+        WriteFile(file, buffer, (DWORD)std::strlen(buffer), &written, nullptr);
+    }
+
+    for (int i = 0; i < address_count; ++i) {
+        if (frame_module[i] != -1) {
+            std::snprintf(buffer, sizeof(buffer), "M%d+0x%" PRIPTRSIZE PRIXPTR "\r\n", frame_module[i], (uintptr_t)addresses[i] - (uintptr_t)modules[frame_module[i]]);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "?+0x%" PRIPTRSIZE PRIXPTR "\r\n", (uintptr_t)addresses[i]);
+        }
+        WriteFile(file, buffer, (DWORD)std::strlen(buffer), &written, nullptr);
+    }
+
+    CloseHandle(file);
+
+    return true;
+}
+
+
+/**
+ *  Enable writing raw module relative addresses to the given file instead of
+ *  resolving symbols. Pass nullptr to disable.
+ */
+void Stack_Dump_Set_Raw(const char *filename)
+{
+    RawStackDumps = (filename != nullptr);
+
+    if (filename != nullptr) {
+        std::strncpy(RawStackDumpFilename, filename, sizeof(RawStackDumpFilename)-1);
+        RawStackDumpFilename[sizeof(RawStackDumpFilename)-1] = '\0';
     }
 }
 
@@ -228,6 +355,12 @@ void Make_Stack_Trace(register_t instructionptr, register_t stackptr, register_t
      */
     DWORD machine_type = IMAGE_FILE_MACHINE_I386;
 
+    /**
+     *  The return addresses captured from the stack walk.
+     */
+    void *addresses[STACK_DEPTH_MAX];
+    int address_count = 0;
+
     if (callback != nullptr) {
         callback("Call Stack:\r\n");
     }
@@ -269,6 +402,9 @@ void Make_Stack_Trace(register_t instructionptr, register_t stackptr, register_t
         /**
          *  We skipped the specified stack frames, now we fetch the important information
          *  from the call stack at the depth specified by STACK_DEPTH_MAX.
+         * 
+         *  Only the return addresses are captured while walking, the (expensive) symbol
+         *  lookups are performed afterwards, and only for addresses not already cached.
          */
         if (carry_on) {
             for (int i = STACK_DEPTH_MAX; i > 0; --i) {
@@ -295,11 +431,28 @@ void Make_Stack_Trace(register_t instructionptr, register_t stackptr, register_t
                 }
 
                 if (carry_on) {
-                    Write_Stack_Line((void *)stack_frame.AddrPC.Offset, callback);
+                    addresses[address_count++] = (void *)stack_frame.AddrPC.Offset;
                 }
             }
         }
     //}
+
+    /**
+     *  Write the raw addresses to their own file, falling back to resolving
+     *  the symbols if the file can not be written.
+     */
+    if (RawStackDumps && Write_Raw_Stack(addresses, address_count)) {
+        if (callback != nullptr) {
+            char buffer[PATH_MAX+64];
+            std::snprintf(buffer, sizeof(buffer), "  Raw addresses written to \"%s\".\r\n", RawStackDumpFilename);
+            callback(buffer);
+        }
+        return;
+    }
+
+    for (int i = 0; i < address_count; ++i) {
+        Write_Stack_Line(addresses[i], callback);
+    }
 }
 
 
@@ -35,6 +35,15 @@
 #include "asserthandler.h"
 #include "debughandler.h"
 #include "options.h"
+#include "tibsun_globals.h"
+#include <Windows.h>
+
+
+int AnimClassExtension::AITimeFrame = -1;
+int AnimClassExtension::AICount = 0;
+int AnimClassExtension::AILastCount = 0;
+long long AnimClassExtension::AITime = 0;
+long long AnimClassExtension::AILastTime = 0;
 
 
 /**
@@ -336,3 +345,79 @@ bool AnimClassExtension::Spawn_Animations(const Coord &coord, const TypeList<Ani
 
     return true;
 }
+
+
+/**
+ *  Returns the current performance counter value, used as the start of an AI timing sample.
+ *
+ *  @author: CCHyper
+ */
+long long AnimClassExtension::AI_Timestamp()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+
+/**
+ *  Adds the time since "start" to the anim logic time of the current frame.
+ *
+ *  @author: CCHyper
+ */
+void AnimClassExtension::Record_AI_Time(long long start)
+{
+    const long long ticks = AI_Timestamp() - start;
+
+    if (AITimeFrame != Frame) {
+        AILastCount = AICount;
+        AILastTime = AITime;
+        AICount = 0;
+        AITime = 0;
+        AITimeFrame = Frame;
+    }
+
+    ++AICount;
+    AITime += ticks;
+}
+
+
+/**
+ *  Returns the number of anims processed on the last game frame.
+ *
+ *  @author: CCHyper
+ */
+int AnimClassExtension::AI_Count_Last_Frame()
+{
+    if (AITimeFrame == Frame) {
+        return AILastCount;
+    }
+
+    if (AITimeFrame == Frame-1) {
+        return AICount;
+    }
+
+    return 0;
+}
+
+
+/**
+ *  Returns the time spent processing anims on the last game frame, in microseconds.
+ *
+ *  @author: CCHyper
+ */
+double AnimClassExtension::AI_Time_Last_Frame()
+{
+    long long ticks = 0;
+
+    if (AITimeFrame == Frame) {
+        ticks = AILastTime;
+    } else if (AITimeFrame == Frame-1) {
+        ticks = AITime;
+    }
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    return double(ticks) * 1000000.0 / double(frequency.QuadPart);
+}
@@ -71,6 +71,11 @@ AnimClassExtension final : public ObjectClassExtension
         bool Middle();
         bool End();
 
+        static long long AI_Timestamp();
+        static void Record_AI_Time(long long start);
+        static int AI_Count_Last_Frame();
+        static double AI_Time_Last_Frame();
+
     private:
         bool Spawn_Animations(const Coord &coord, const TypeList<AnimTypeClass *> &animlist, const TypeList<int> &countlist, const TypeList<int> &minlist, const TypeList<int> &maxlist, const TypeList<int>& delaylist);
 
@@ -79,4 +84,15 @@ AnimClassExtension final : public ObjectClassExtension
          *  Separate StageClass instance for damage dealing, to separate it from visual stages.
          */
         StageClass DamageStage;
+
+    private:
+        /**
+         *  Per-frame anim logic timing, only recorded while the developer
+         *  statistics overlay is shown.
+         */
+        static int AITimeFrame;
+        static int AICount;
+        static int AILastCount;
+        static long long AITime;
+        static long long AILastTime;
 };
@@ -55,6 +55,7 @@
 #include "overlay.h"
 #include "tactical.h"
 #include "tiberium.h"
+#include "vinifera_globals.h"
 
 #include "hooker.h"
 #include "hooker_macros.h"
@@ -72,6 +73,7 @@ DECLARE_EXTENDING_CLASS_AND_PAIR(AnimClass)
 public:
     LayerType _In_Which_Layer() const;
     void _AI();
+    void _Anim_AI();
     void _Start();
     void _Middle();
     void _Delete_Me();
@@ -141,9 +143,30 @@ static void Do_Anim_Damage(AnimClass* anim, int damage)
 /**
  *  Reimplementation of AnimClass::AI.
  *
- *  @author: ZivDero
+ *  @author: ZivDero, CCHyper
  */
 void AnimClassExt::_AI()
+{
+    /**
+     *  Time the anim logic while the developer statistics overlay is shown.
+     */
+    if (Vinifera_DeveloperMode && Vinifera_Developer_ShowStatistics) {
+        const long long start = AnimClassExtension::AI_Timestamp();
+        _Anim_AI();
+        AnimClassExtension::Record_AI_Time(start);
+        return;
+    }
+
+    _Anim_AI();
+}
+
+
+/**
+ *  The anim logic.
+ *
+ *  @author: ZivDero
+ */
+void AnimClassExt::_Anim_AI()
 {
     const auto animext = Extension::Fetch(this);
     auto animtypeext = Extension::Fetch(Class);
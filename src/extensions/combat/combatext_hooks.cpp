@@ -30,6 +30,7 @@
 #include "buildingext_hooks.h"
 #include <algorithm>
 #include <unordered_set>
+#include <vector>
 #include "aircraft.h"
 #include "aircrafttracker.h"
 #include "anim.h"
@@ -238,8 +239,108 @@ static bool Is_On_High_Bridge(const Coord& coord)
 }
 
 
+/**
+ *  Visit record for an object found while collecting explosion targets. A record
+ *  is only valid if its stamp matches the current explosion, so the table never
+ *  needs to be cleared between explosions.
+ */
+typedef struct ExplosionVisitStruct
+{
+    ObjectClass *Object;
+    unsigned Stamp;
+
+    /**
+     *  Can this object be damaged by the explosion at all?
+     */
+    bool IsAccepted;
+
+    /**
+     *  Position in the candidate list of the last time this object was found.
+     */
+    int LastIndex;
+} ExplosionVisitStruct;
+
+/**
+ *  A target found while sweeping the cells, in the order it was found.
+ */
+typedef struct ExplosionCandidateStruct
+{
+    ObjectClass *Object;
+    bool IsVeinhole;
+} ExplosionCandidateStruct;
+
+static ExplosionVisitStruct *ExplosionVisits = nullptr;
+static int ExplosionVisitsSize = 0;
+static int ExplosionVisitsUsed = 0;
+static unsigned ExplosionStamp = 0;
+static std::vector<ExplosionCandidateStruct> ExplosionCandidates;
+
+
+/**
+ *  Finds the visit record for the object in the current explosion, adding a new
+ *  record if the object has not been visited yet.
+ *
+ *  @author: CCHyper
+ */
+static ExplosionVisitStruct &Explosion_Visit(ObjectClass *object, bool &is_new)
+{
+    /**
+     *  Keep the table at most half full so the probe sequences stay short.
+     */
+    if ((ExplosionVisitsUsed + 1) * 2 > ExplosionVisitsSize) {
+
+        ExplosionVisitStruct *old_visits = ExplosionVisits;
+        int old_size = ExplosionVisitsSize;
+
+        ExplosionVisitsSize = std::max(256, ExplosionVisitsSize * 2);
+        ExplosionVisits = new ExplosionVisitStruct [ExplosionVisitsSize];
+        std::memset(ExplosionVisits, 0, sizeof(ExplosionVisitStruct) * ExplosionVisitsSize);
+        ExplosionVisitsUsed = 0;
+
+        for (int i = 0; i < old_size; ++i) {
+            if (old_visits[i].Stamp == ExplosionStamp) {
+                bool dummy;
+                Explosion_Visit(old_visits[i].Object, dummy) = old_visits[i];
+            }
+        }
+
+        delete [] old_visits;
+    }
+
+    unsigned mask = ExplosionVisitsSize - 1;
+    unsigned index = ((uintptr_t)object >> 3) * 2654435761U;
+
+    while (true) {
+        index &= mask;
+        ExplosionVisitStruct &visit = ExplosionVisits[index];
+
+        if (visit.Stamp != ExplosionStamp) {
+            visit.Object = object;
+            visit.Stamp = ExplosionStamp;
+            visit.IsAccepted = false;
+            visit.LastIndex = -1;
+            ++ExplosionVisitsUsed;
+            is_new = true;
+            return visit;
+        }
+
+        if (visit.Object == object) {
+            is_new = false;
+            return visit;
+        }
+
+        ++index;
+    }
+}
+
+
 /**
  *  Collects the targets to deal damage to in a certain range.
+ * 
+ *  Large buildings occupy many cells, so the same object is usually found several
+ *  times. The list must end up in the same order as if each object was removed
+ *  and re-added every time it was found, so the cells are swept first and each
+ *  object is then added at the position it was last found.
  *
  *  @author: ZivDero
  */
@@ -254,6 +355,19 @@ void Get_Explosion_Targets(const Coord& coord, TechnoClass* source, int range, D
     int cell_radius = (range + CELL_LEPTON_W - 1) / CELL_LEPTON_W;
 
     const bool isbridge = cellptr->IsUnderBridge && coord.Z > BRIDGE_LEPTON_HEIGHT / 2 + Map.Get_Height_GL(coord);
+    const bool harvester_immune = Scen->Special.IsHarvesterImmune;
+
+    /**
+     *  Start a new explosion, invalidating all the previous visit records.
+     */
+    if (++ExplosionStamp == 0) {
+        if (ExplosionVisits) {
+            std::memset(ExplosionVisits, 0, sizeof(ExplosionVisitStruct) * ExplosionVisitsSize);
+        }
+        ExplosionStamp = 1;
+    }
+    ExplosionVisitsUsed = 0;
+    ExplosionCandidates.clear();
 
     /**
      *  Fill the list of unit IDs that will have damage
@@ -278,9 +392,21 @@ void Get_Explosion_Targets(const Coord& coord, TechnoClass* source, int range, D
             object = cellptr->Cell_Occupier(isbridge);
             while (object) {
                 if (object != source) {
-                    if (object->RTTI != RTTI_UNIT || !Scen->Special.IsHarvesterImmune || !Rule->HarvesterUnit.Is_Present((UnitTypeClass*)object->Class_Of())) {
-                        objects.Delete(object);
-                        objects.Add(object);
+
+                    bool is_new;
+                    ExplosionVisitStruct &visit = Explosion_Visit(object, is_new);
+
+                    /**
+                     *  Whether the object can be damaged does not change between cells,
+                     *  so only check it the first time it is found.
+                     */
+                    if (is_new) {
+                        visit.IsAccepted = object->RTTI != RTTI_UNIT || !harvester_immune || !Rule->HarvesterUnit.Is_Present((UnitTypeClass*)object->Class_Of());
+                    }
+
+                    if (visit.IsAccepted) {
+                        visit.LastIndex = ExplosionCandidates.size();
+                        ExplosionCandidates.push_back(ExplosionCandidateStruct { object, false });
                     }
                 }
                 object = object->Next;
@@ -294,12 +420,41 @@ void Get_Explosion_Targets(const Coord& coord, TechnoClass* source, int range, D
                     VeinholeMonsterClass* veinhole = VeinholeMonsterClass::Fetch_At(cell);
                     if (veinhole) {
                         //objects.Delete(veinhole); // vanilla doesn't do this, let's not do this either just in case it's intended.
-                        objects.Add(veinhole);
+                        ExplosionCandidates.push_back(ExplosionCandidateStruct { veinhole, true });
                     }
                 }
             }
         }
     }
+
+    /**
+     *  Anything already in the list that was found again would have been removed
+     *  and re-added at the end.
+     */
+    for (int index = objects.Count() - 1; index >= 0; --index) {
+        bool is_new;
+        ExplosionVisitStruct &visit = Explosion_Visit(objects[index], is_new);
+        if (!is_new && visit.IsAccepted) {
+            objects.Delete(index);
+        }
+    }
+
+    /**
+     *  Add each object at the position it was last found. The veinhole monster is
+     *  never removed from the list, so every time it was found is kept.
+     */
+    for (int index = 0; index < ExplosionCandidates.size(); ++index) {
+        const ExplosionCandidateStruct &candidate = ExplosionCandidates[index];
+        if (candidate.IsVeinhole) {
+            objects.Add(candidate.Object);
+            continue;
+        }
+
+        bool is_new;
+        if (Explosion_Visit(candidate.Object, is_new).LastIndex == index) {
+            objects.Add(candidate.Object);
+        }
+    }
 }
 
 
@@ -93,6 +93,8 @@
 #include "bullettype.h"
 #include "eventext.h"
 #include "houseext.h"
+#include "memorytelemetry.h"
+#include "eventtelemetry.h"
 
 
 /**
@@ -4235,3 +4237,143 @@ bool MeteorImpactCommandClass::Process()
 
     return true;
 }
+
+
+/**
+ *  Toggles the developer statistics overlay.
+ * 
+ *  @author: CCHyper
+ */
+const char *ToggleStatisticsCommandClass::Get_Name() const
+{
+    return "ToggleStatistics";
+}
+
+const char *ToggleStatisticsCommandClass::Get_UI_Name() const
+{
+    return "Toggle Statistics";
+}
+
+const char *ToggleStatisticsCommandClass::Get_Category() const
+{
+    return CATEGORY_DEVELOPER;
+}
+
+const char *ToggleStatisticsCommandClass::Get_Description() const
+{
+    return "Toggles the developer statistics overlay.";
+}
+
+bool ToggleStatisticsCommandClass::Process()
+{
+    /**
+     *  Toggle the show statistics flag.
+     */
+    Vinifera_Developer_ShowStatistics = !Vinifera_Developer_ShowStatistics;
+
+    return true;
+}
+
+
+/**
+ *  Toggles streaming of the memory telemetry to a CSV log.
+ *
+ *  @author: CCHyper
+ */
+const char *ToggleTelemetryLogCommandClass::Get_Name() const
+{
+    return "ToggleTelemetryLog";
+}
+
+const char *ToggleTelemetryLogCommandClass::Get_UI_Name() const
+{
+    return "Toggle Telemetry Log";
+}
+
+const char *ToggleTelemetryLogCommandClass::Get_Category() const
+{
+    return CATEGORY_DEVELOPER;
+}
+
+const char *ToggleTelemetryLogCommandClass::Get_Description() const
+{
+    return "Toggles writing the memory and object count telemetry to a CSV log in the debug directory.";
+}
+
+bool ToggleTelemetryLogCommandClass::Process()
+{
+    if (MemoryTelemetry::Is_Logging()) {
+        MemoryTelemetry::Stop_Log();
+        return true;
+    }
+
+    return MemoryTelemetry::Start_Log();
+}
+
+
+/**
+ *  Toggles recording of the event queue telemetry.
+ *
+ *  @author: CCHyper
+ */
+const char *ToggleEventTelemetryCommandClass::Get_Name() const
+{
+    return "ToggleEventTelemetry";
+}
+
+const char *ToggleEventTelemetryCommandClass::Get_UI_Name() const
+{
+    return "Toggle Event Telemetry";
+}
+
+const char *ToggleEventTelemetryCommandClass::Get_Category() const
+{
+    return CATEGORY_DEVELOPER;
+}
+
+const char *ToggleEventTelemetryCommandClass::Get_Description() const
+{
+    return "Toggles recording of event queue delays, execution times and per house event rates.";
+}
+
+bool ToggleEventTelemetryCommandClass::Process()
+{
+    if (EventTelemetry::Is_Enabled()) {
+        EventTelemetry::Stop();
+    } else {
+        EventTelemetry::Start();
+    }
+
+    return true;
+}
+
+
+/**
+ *  Writes the event queue telemetry to a CSV file.
+ *
+ *  @author: CCHyper
+ */
+const char *DumpEventTelemetryCommandClass::Get_Name() const
+{
+    return "DumpEventTelemetry";
+}
+
+const char *DumpEventTelemetryCommandClass::Get_UI_Name() const
+{
+    return "Dump Event Telemetry";
+}
+
+const char *DumpEventTelemetryCommandClass::Get_Category() const
+{
+    return CATEGORY_DEVELOPER;
+}
+
+const char *DumpEventTelemetryCommandClass::Get_Description() const
+{
+    return "Writes the recorded event queue telemetry to a CSV file in the debug directory.";
+}
+
+bool DumpEventTelemetryCommandClass::Process()
+{
+    return EventTelemetry::Write_CSV();
+}
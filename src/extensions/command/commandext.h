@@ -1467,3 +1467,79 @@ public:
 
     virtual KeyNumType Default_Key() const override { return KeyNumType(KN_NONE); }
 };
+
+
+/**
+ *  Toggles the developer statistics overlay.
+ */
+class ToggleStatisticsCommandClass : public ViniferaCommandClass
+{
+public:
+    ToggleStatisticsCommandClass() : ViniferaCommandClass() { IsDeveloper = true; }
+    virtual ~ToggleStatisticsCommandClass() {}
+
+    virtual const char *Get_Name() const override;
+    virtual const char *Get_UI_Name() const override;
+    virtual const char *Get_Category() const override;
+    virtual const char *Get_Description() const override;
+    virtual bool Process() override;
+
+    virtual KeyNumType Default_Key() const override { return KeyNumType(KN_NONE); }
+};
+
+
+/**
+ *  Toggles streaming of the memory telemetry to a CSV log.
+ */
+class ToggleTelemetryLogCommandClass : public ViniferaCommandClass
+{
+public:
+    ToggleTelemetryLogCommandClass() : ViniferaCommandClass() { IsDeveloper = true; }
+    virtual ~ToggleTelemetryLogCommandClass() {}
+
+    virtual const char *Get_Name() const override;
+    virtual const char *Get_UI_Name() const override;
+    virtual const char *Get_Category() const override;
+    virtual const char *Get_Description() const override;
+    virtual bool Process() override;
+
+    virtual KeyNumType Default_Key() const override { return KeyNumType(KN_NONE); }
+};
+
+
+/**
+ *  Toggles recording of the event queue telemetry.
+ */
+class ToggleEventTelemetryCommandClass : public ViniferaCommandClass
+{
+public:
+    ToggleEventTelemetryCommandClass() : ViniferaCommandClass() { IsDeveloper = true; }
+    virtual ~ToggleEventTelemetryCommandClass() {}
+
+    virtual const char *Get_Name() const override;
+    virtual const char *Get_UI_Name() const override;
+    virtual const char *Get_Category() const override;
+    virtual const char *Get_Description() const override;
+    virtual bool Process() override;
+
+    virtual KeyNumType Default_Key() const override { return KeyNumType(KN_NONE); }
+};
+
+
+/**
+ *  Writes the event queue telemetry to a CSV file.
+ */
+class DumpEventTelemetryCommandClass : public ViniferaCommandClass
+{
+public:
+    DumpEventTelemetryCommandClass() : ViniferaCommandClass() { IsDeveloper = true; }
+    virtual ~DumpEventTelemetryCommandClass() {}
+
+    virtual const char *Get_Name() const override;
+    virtual const char *Get_UI_Name() const override;
+    virtual const char *Get_Category() const override;
+    virtual const char *Get_Description() const override;
+    virtual bool Process() override;
+
+    virtual KeyNumType Default_Key() const override { return KeyNumType(KN_NONE); }
+};
@@ -293,6 +293,10 @@ void Init_Vinifera_Commands()
         Commands.Add(new ReloadRulesCommandClass);
         Commands.Add(new MeteorShowerCommandClass);
         Commands.Add(new MeteorImpactCommandClass);
+        Commands.Add(new ToggleStatisticsCommandClass);
+        Commands.Add(new ToggleTelemetryLogCommandClass);
+        Commands.Add(new ToggleEventTelemetryCommandClass);
+        Commands.Add(new DumpEventTelemetryCommandClass);
     }
 
     /**
@@ -74,6 +74,12 @@ class DisplayClassExt final : public DisplayClass
  * 
  *  Searches for next object on display.
  * 
+ *  #TODO:
+ *  This walks every object in the display layers on each key press. A per player
+ *  index of the army would avoid that, but it has to follow the layer order, so it
+ *  would need to be kept up to date from the layer add, remove and sort code, and
+ *  on ownership and selectability changes. It is not implemented yet.
+ * 
  *  @author: 06/20/1994 JLB - Red Alert source code.
  *           CCHyper - Adjustments for Tiberian Sun.
  */
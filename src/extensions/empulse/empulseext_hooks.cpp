@@ -52,20 +52,24 @@ DECLARE_PATCH(_EMPulseClass_Create_Building_EMPImmune_Patch)
     GET_REGISTER_STATIC(BuildingTypeClass *, buildingtype, eax);
     static BuildingTypeClassExtension *exttype_ptr;
 
-    exttype_ptr = Extension::Fetch(buildingtype);
-
     /**
-     *  Is this building immune to EMP weapons?
+     *  Stolen bytes / code.
+     * 
+     *  This is tested first as it is a plain member read, so invisible
+     *  buildings (such as bridge repair huts and light posts) filling the
+     *  pulse radius never reach the extension lookup below.
      */
-    if (exttype_ptr->IsImmuneToEMP) {
+original_code:
+    if (buildingtype->IsInvisibleInGame) {
         goto loop_continue;
     }
 
+    exttype_ptr = Extension::Fetch(buildingtype);
+
     /**
-     *  Stolen bytes / code.
+     *  Is this building immune to EMP weapons?
      */
-original_code:
-    if (buildingtype->IsInvisibleInGame) {
+    if (exttype_ptr->IsImmuneToEMP) {
         goto loop_continue;
     }
 
@@ -36,6 +36,25 @@
 #include "hooker.h"
 #include "hooker_macros.h"
 #include "house.h"
+#include "eventtelemetry.h"
+
+
+/**
+ *  Executes one of our events, timing it if the event telemetry is enabled.
+ *
+ *  @author: CCHyper
+ */
+static void Execute_Vinifera_Event(EventClassExt *event)
+{
+    if (!EventTelemetry::Is_Enabled()) {
+        event->Execute();
+        return;
+    }
+
+    long long start = EventTelemetry::Timestamp();
+    event->Execute();
+    EventTelemetry::Record_Execution(event->Type, start);
+}
 
 
 /**
@@ -49,8 +68,12 @@ DECLARE_PATCH(_EventClass_Execute_New_Events)
 
     _asm pushad
 
+    if (EventTelemetry::Is_Enabled()) {
+        EventTelemetry::Record_Event(event->As_Event());
+    }
+
     if (event->Is_Vinifera_Event()) {
-        event->Execute();
+        Execute_Vinifera_Event(event);
         _asm popad
         JMP(0x00495110); // return
     }
@@ -513,6 +513,13 @@ DECLARE_PATCH(_FootClass_Mission_Move_Can_Passive_Acquire_Patch)
         goto finish_mission_process;
     }
 
+    /**
+     *  Is it our turn to scan for targets?
+     */
+    if (!technoclassext->Is_Passive_Acquire_Scan_Due()) {
+        goto finish_mission_process;
+    }
+
     /**
      *  Find a fresh target within my range.
      */
@@ -544,6 +551,13 @@ DECLARE_PATCH(_FootClass_Mission_Guard_Can_Passive_Acquire_Patch)
         goto continue_check;
     }
 
+    /**
+     *  Is it our turn to scan for targets?
+     */
+    if (!technoclassext->Is_Passive_Acquire_Scan_Due()) {
+        goto continue_check;
+    }
+
     /**
      *  Find a fresh target within my range.
      */
@@ -581,6 +595,13 @@ DECLARE_PATCH(_FootClass_Mission_Guard_Area_Can_Passive_Acquire_Patch)
         goto tarcom_check;
     }
 
+    /**
+     *  Is it our turn to scan for targets?
+     */
+    if (!technoclassext->Is_Passive_Acquire_Scan_Due()) {
+        goto tarcom_check;
+    }
+
     /**
      *  Find a fresh target in my area using the backup target.
      */
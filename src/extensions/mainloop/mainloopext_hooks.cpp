@@ -46,6 +46,8 @@
 #include "hooker_macros.h"
 #include "rulesext.h"
 #include "voxelinit.h"
+#include "memorytelemetry.h"
+#include "eventtelemetry.h"
 
 
 /**
@@ -79,11 +81,25 @@ create_event:
 
 static void Before_Main_Loop()
 {
+    /**
+     *  Note any events queued since the end of the last main loop.
+     */
+    if (Vinifera_DeveloperMode && GameActive) {
+        EventTelemetry::Record_Queued();
+    }
 }
 
 
 static void After_Main_Loop()
 {
+    /**
+     *  Sample the memory and event telemetry for the developer overlay and logs.
+     */
+    if (Vinifera_DeveloperMode && GameActive) {
+        MemoryTelemetry::Update();
+        EventTelemetry::Update();
+    }
+
     /**
      *  Has we been flagged to reload the rules data?
      */
@@ -85,6 +85,12 @@ DECLARE_PATCH(_MessageListClass_Echo_Sent_Messages_Patch)
 
 /**
  *  Main function for patching the hooks.
+ * 
+ *  #TODO:
+ *  Each message label measures its text with the font on every redraw. Laying out
+ *  (and wrapping) the message once in Add_Message, and evicting messages by count
+ *  and age, needs MessageListClass::Add_Message and Draw reimplemented here. It is
+ *  not implemented yet.
  */
 void MessageListClassExtension_Hooks()
 {
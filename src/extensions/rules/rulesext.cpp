@@ -93,7 +93,8 @@ RulesClassExtension::RulesClassExtension(const RulesClass *this_ptr) :
     VoxelLightAzimuth(0),
     VoxelLightElevation(DEG_TO_RAD(45)),
     VoxelShadowOffset(6),
-    IsTiberiumStorage(true)
+    IsTiberiumStorage(true),
+    PassiveAcquireScanInterval(1)
 {
     //if (this_ptr) EXT_DEBUG_TRACE("RulesClassExtension::RulesClassExtension - 0x%08X\n", (uintptr_t)(ThisPtr));
 
@@ -228,6 +229,7 @@ void RulesClassExtension::Object_CRC(CRCEngine &crc) const
     crc(IsRecheckPrerequisites);
     crc(IsMultiMCV);
     crc(AINavalYardAdjacency);
+    crc(PassiveAcquireScanInterval);
 }
 
 
@@ -378,6 +380,11 @@ void RulesClassExtension::Process(CCINIClass &ini)
      *  Fixup various inconsistencies in the original INI files.
      */
     Fixups(ini);
+
+    /**
+     *  All armors and warheads are now known, so build the Verses lookup tables.
+     */
+    Verses::Resolve();
 }
 
 
@@ -657,6 +664,7 @@ bool RulesClassExtension::General(CCINIClass &ini)
     LowPowerPenaltyModifier = ini.Get_Float(GENERAL, "LowPowerPenaltyModifier", LowPowerPenaltyModifier);
     MultipleFactoryCap = ini.Get_Int(GENERAL, "MultipleFactoryCap", MultipleFactoryCap);
     IsTiberiumStorage = ini.Get_Bool(GENERAL, "TiberiumStorage", IsTiberiumStorage);
+    PassiveAcquireScanInterval = std::max(1, ini.Get_Int(GENERAL, "PassiveAcquireScanInterval", PassiveAcquireScanInterval));
 
     return true;
 }
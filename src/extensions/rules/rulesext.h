@@ -168,4 +168,10 @@ class RulesClassExtension final : public GlobalExtensionClass<RulesClass>
          *  Determines whether the Tiberium storage logic is enabled.
          */
         bool IsTiberiumStorage;
+
+        /**
+         *  The interval, in frames, between passive target acquisition scans of
+         *  idle units. Scans are spread across this many frames by object ID.
+         */
+        int PassiveAcquireScanInterval;
 };
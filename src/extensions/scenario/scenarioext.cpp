@@ -47,6 +47,8 @@
 #include "vinifera_saveload.h"
 #include "asserthandler.h"
 #include "debughandler.h"
+#include <Windows.h>
+#include <vector>
 
 
 /**
@@ -956,14 +958,73 @@ static Cell Clip_Move(Cell cell, FacingType facing, int dist)
 
 
 /**
- *  Places an object >near< the given cell.
+ *  The furthest distance from the center cell the placement cache supports.
+ */
+#define SCAN_PLACE_MAX_DISTANCE 32
+
+
+/**
+ *  Placement state of a single object type around the cached center cell.
+ */
+struct ScanPlaceCursorStruct
+{
+    const ObjectTypeClass *Type;
+
+    /**
+     *  The nearest distance at which this type could still be placed, zero
+     *  if the center cell itself has not been found to be blocked yet.
+     */
+    int FirstOpen;
+};
+
+
+/**
+ *  Caches the cells probed around a center cell when placing many objects
+ *  without scatter, such as the starting units of a house.
+ *
+ *  Placement only ever adds objects to the map, so once every cell at a
+ *  distance has refused an object type, it will refuse it again. Each type
+ *  remembers the nearest distance it could still be placed at, and the
+ *  distances before it are skipped. The random direction is still picked
+ *  for the skipped distances so the random number sequence is unchanged.
+ */
+struct ScanPlaceCacheStruct
+{
+    ScanPlaceCacheStruct(Cell center) : Center(center), Cursors()
+    {
+        for (int dist = 0; dist <= SCAN_PLACE_MAX_DISTANCE; dist++) {
+            for (FacingType facing = FACING_N; facing <= FACING_NW; facing++) {
+                Spokes[dist][facing] = Clip_Move(center, facing, dist);
+            }
+        }
+    }
+
+    ScanPlaceCursorStruct &Cursor(const ObjectTypeClass *type)
+    {
+        for (ScanPlaceCursorStruct &cursor : Cursors) {
+            if (cursor.Type == type) {
+                return cursor;
+            }
+        }
+        Cursors.push_back(ScanPlaceCursorStruct{type, 0});
+        return Cursors.back();
+    }
+
+    Cell Center;
+    Cell Spokes[SCAN_PLACE_MAX_DISTANCE+1][FACING_COUNT];
+    std::vector<ScanPlaceCursorStruct> Cursors;
+};
+
+
+/**
+ *  Places an object >near< the given cell, using the placement cache if one is given.
  * 
  *  @author: 06/09/1995 BRR - Red Alert source code.
  *           CCHyper - Adjustments for Tiberian Sun.
  * 
  *  #issue-338 - Adds "min_dist" argument.
  */
-int Vinifera_Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist = 1, int max_dist = 31, bool no_scatter = false)
+static int Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist, int max_dist, bool no_scatter, ScanPlaceCacheStruct *cache)
 {
     int dist;               // for object placement
     FacingType rot;         // for object placement
@@ -973,10 +1034,18 @@ int Vinifera_Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist = 1, in
     TechnoClass *techno;
     bool skipit;
 
+    /**
+     *  The cache only knows the cells along the spokes, so it can't be used with scatter.
+     */
+    ScanPlaceCursorStruct *cursor = nullptr;
+    if (cache && no_scatter && cache->Center == cell && max_dist <= SCAN_PLACE_MAX_DISTANCE) {
+        cursor = &cache->Cursor(obj->Class_Of());
+    }
+
     /**
      *  First try to unlimbo the object in the given cell.
      */
-    if (Map.In_Radar(cell)) {
+    if ((!cursor || !cursor->FirstOpen) && Map.In_Radar(cell)) {
         techno = Map[cell].Cell_Techno();
         if (!techno || (techno->RTTI == RTTI_INFANTRY &&
             obj->RTTI == RTTI_INFANTRY)) {
@@ -1002,6 +1071,13 @@ int Vinifera_Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist = 1, in
          */
         rot = Random_Pick(FACING_N, FACING_NW);
 
+        /**
+         *  Every cell at this distance has already refused this type of object.
+         */
+        if (cursor && dist < cursor->FirstOpen) {
+            continue;
+        }
+
         /**
          *  Try all directions twice
          */
@@ -1017,7 +1093,7 @@ int Vinifera_Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist = 1, in
                 /**
                  *  Pick a coordinate along this directional axis
                  */
-                newcell = Clip_Move(cell, rot, dist);
+                newcell = cursor ? cache->Spokes[dist][rot] : Clip_Move(cell, rot, dist);
 
                 /**
                  *  If this is our second try at this distance, add a random scatter
@@ -1048,6 +1124,9 @@ int Vinifera_Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist = 1, in
                         Coord coord = newcell.As_Coord();
                         coord.Z = Map.Get_Height_GL(coord);
                         if (obj->Unlimbo(coord, DIR_N)) {
+                            if (cursor) {
+                                cursor->FirstOpen = dist;
+                            }
                             return true;
                         }
                     }
@@ -1061,10 +1140,25 @@ int Vinifera_Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist = 1, in
         }
     }
 
+    if (cursor) {
+        cursor->FirstOpen = max_dist+1;
+    }
+
     return false;
 }
 
 
+/**
+ *  Places an object >near< the given cell.
+ * 
+ *  @author: CCHyper
+ */
+int Vinifera_Scan_Place_Object(ObjectClass *obj, Cell cell, int min_dist = 1, int max_dist = 31, bool no_scatter = false)
+{
+    return Scan_Place_Object(obj, cell, min_dist, max_dist, no_scatter, nullptr);
+}
+
+
 /**
  *  Checks if the cell adjacent from the input cell is occupied.
  * 
@@ -1248,15 +1342,16 @@ void ScenarioClassExtension::Create_Units(bool official)
 
     /**
      *  Generate lists of all the available starting units (regardless of owner).
+     *  The lists for each house are filtered from these.
      */
-    int tot_inf_count = 0;
-    int tot_unit_count = 0;
+    DynamicVectorClass<UnitTypeClass *> starting_units;
+    DynamicVectorClass<InfantryTypeClass *> starting_infantry;
 
     for (int i = 0; i < UnitTypes.Count(); ++i) {
         UnitTypeClass *unittype = UnitTypes[i];
         if (unittype && unittype->IsAllowedToStartInMultiplayer) {
             if (Rule->BaseUnit->Fetch_ID() != unittype->Fetch_ID()) {
-                ++tot_unit_count;
+                starting_units.Add(unittype);
             }
         }
     }
@@ -1264,10 +1359,13 @@ void ScenarioClassExtension::Create_Units(bool official)
     for (int i = 0; i < InfantryTypes.Count(); ++i) {
         InfantryTypeClass *infantrytype = InfantryTypes[i];
         if (infantrytype && infantrytype->IsAllowedToStartInMultiplayer) {
-            ++tot_inf_count;
+            starting_infantry.Add(infantrytype);
         }
     }
 
+    int tot_inf_count = starting_infantry.Count();
+    int tot_unit_count = starting_units.Count();
+
     if (!(tot_inf_count + tot_unit_count)) {
         DEBUG_WARNING("No starting units available!");
     }
@@ -1315,6 +1413,12 @@ void ScenarioClassExtension::Create_Units(bool official)
 
         int owner_id = 1 << hptr->Class->HeapID;
 
+        /**
+         *  Time how long it takes to generate the units for each house.
+         */
+        LARGE_INTEGER house_start;
+        QueryPerformanceCounter(&house_start);
+
         DEBUG_INFO("Generating units for house %d (Name: %s - \"%s\", Color: %s)...\n",
             house, hptr->Class->Name(), hptr->IniName, ColorSchemes[hptr->RemapColor]->Name);
 
@@ -1322,27 +1426,15 @@ void ScenarioClassExtension::Create_Units(bool official)
          *  Generate list of starting units for this house.
          */
         DEBUG_INFO("  Creating list of available UnitTypes...\n");
-        for (int i = 0; i < UnitTypes.Count(); ++i) {
-            UnitTypeClass *unittype = UnitTypes[i];
-            if (unittype) {
-
-                /**
-                 *  Is this unit allowed to be placed in multiplayer?
-                 */
-                if (!unittype->IsAllowedToStartInMultiplayer) {
-                    continue;
-                }
-
-                /**
-                 *  Check tech level and ownership.
-                 */
-                if (unittype->TechLevel <= hptr->Control.TechLevel && (owner_id & unittype->Ownable) != 0) {
+        for (int i = 0; i < starting_units.Count(); ++i) {
+            UnitTypeClass *unittype = starting_units[i];
 
-                    if (Rule->BaseUnit->Fetch_ID() != unittype->Fetch_ID()) {
-                        DEBUG_INFO("    Added %s\n", unittype->Name());
-                        available_units.Add(unittype);
-                    }
-                }
+            /**
+             *  Check tech level and ownership.
+             */
+            if (unittype->TechLevel <= hptr->Control.TechLevel && (owner_id & unittype->Ownable) != 0) {
+                DEBUG_INFO("    Added %s\n", unittype->Name());
+                available_units.Add(unittype);
             }
         }
 
@@ -1350,24 +1442,15 @@ void ScenarioClassExtension::Create_Units(bool official)
          *  Generate list of starting infantry for this house.
          */
         DEBUG_INFO("  Creating list of available InfantryTypes...\n");
-        for (int i = 0; i < InfantryTypes.Count(); ++i) {
-            InfantryTypeClass *infantrytype = InfantryTypes[i];
-            if (infantrytype) {
-
-                /**
-                 *  Is this unit allowed to be placed in multiplayer?
-                 */
-                if (!infantrytype->IsAllowedToStartInMultiplayer) {
-                    continue;
-                }
+        for (int i = 0; i < starting_infantry.Count(); ++i) {
+            InfantryTypeClass *infantrytype = starting_infantry[i];
 
-                /**
-                 *  Check tech level and ownership.
-                 */
-                if (infantrytype->TechLevel <= hptr->Control.TechLevel && (owner_id & infantrytype->Ownable) != 0) {
-                    available_infantry.Add(infantrytype);
-                    DEBUG_INFO("    Added %s\n", infantrytype->Name());
-                }
+            /**
+             *  Check tech level and ownership.
+             */
+            if (infantrytype->TechLevel <= hptr->Control.TechLevel && (owner_id & infantrytype->Ownable) != 0) {
+                available_infantry.Add(infantrytype);
+                DEBUG_INFO("    Added %s\n", infantrytype->Name());
             }
         }
 
@@ -1555,6 +1638,11 @@ void ScenarioClassExtension::Create_Units(bool official)
 
         if (units_available) {
 
+            /**
+             *  All the starting units of this house are placed around the same cell.
+             */
+            ScanPlaceCacheStruct placement_cache(centroid);
+
             TechnoTypeClass *technotype = nullptr;
 
             int inf_percent = 50;
@@ -1606,7 +1694,7 @@ void ScenarioClassExtension::Create_Units(bool official)
                     obj = reinterpret_cast<TechnoClass *>(technotype->Create_One_Of(hptr));
                     if (obj) {
 
-                        if (Vinifera_Scan_Place_Object(obj, centroid, MIN_PLACEMENT_DISTANCE, MAX_PLACEMENT_DISTANCE, true)) {
+                        if (Scan_Place_Object(obj, centroid, MIN_PLACEMENT_DISTANCE, MAX_PLACEMENT_DISTANCE, true, &placement_cache)) {
 
                             DEBUG_INFO("  House %s deployed object %s at %d,%d\n",
                                 hptr->Class->Name(), obj->Name(), obj->Get_Cell().X, obj->Get_Cell().Y);
@@ -1658,7 +1746,7 @@ void ScenarioClassExtension::Create_Units(bool official)
                     obj = reinterpret_cast<TechnoClass *>(technotype->Create_One_Of(hptr));
                     if (obj) {
 
-                        if (Vinifera_Scan_Place_Object(obj, centroid, MIN_PLACEMENT_DISTANCE, MAX_PLACEMENT_DISTANCE, true)) {
+                        if (Scan_Place_Object(obj, centroid, MIN_PLACEMENT_DISTANCE, MAX_PLACEMENT_DISTANCE, true, &placement_cache)) {
 
                             DEBUG_INFO("  House %s deployed object %s at %d,%d\n",
                                 hptr->Class->Name(), obj->Name(), obj->Get_Cell().X, obj->Get_Cell().Y);
@@ -1761,6 +1849,14 @@ void ScenarioClassExtension::Create_Units(bool official)
 #endif
 
         }
+
+        LARGE_INTEGER house_end;
+        LARGE_INTEGER frequency;
+        QueryPerformanceCounter(&house_end);
+        QueryPerformanceFrequency(&frequency);
+
+        DEBUG_INFO("  Generated units for house %d in %.3f ms.\n",
+            house, double(house_end.QuadPart - house_start.QuadPart) * 1000.0 / double(frequency.QuadPart));
     }
 
     DEBUG_INFO("Finished unit generation. Random number is %d\n", Scen->RandomNumber);
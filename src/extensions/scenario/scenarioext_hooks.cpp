@@ -46,6 +46,7 @@
 #include "hooker.h"
 #include "hooker_macros.h"
 #include "kamikazetracker.h"
+#include "technoext.h"
 #include "mouse.h"
 #include "vinifera_globals.h"
 
@@ -100,6 +101,8 @@ DECLARE_PATCH(_Clear_Scenario_Patch)
     KamikazeTracker->Clear();
     AircraftTracker->Clear();
 
+    TechnoClassExtension::Clear_Threats();
+
     JMP(0x005DC872);
 }
 
@@ -1175,150 +1175,149 @@ void StripClassExt::_Activate()
 
 
 /**
- *  Comparison function for sorting sidebar icons (BuildTypes)
+ *  Returns the lowest side of all the house types in the ownership mask.
  *
  *  @author: Rampastring, ZivDero
  */
-static int __cdecl BuildType_Comparison(const void* p1, const void* p2)
+static int BuildType_First_Side(unsigned owners)
 {
-    auto firstSide = [](unsigned owners) -> int
-        {
-            int side = INT_MAX;
+    int side = INT_MAX;
 
-            for (int i = 0; i < HouseTypes.Count(); i++)
-            {
-                if (owners & (1 << i))
-                    side = std::min<int>(HouseTypes[i]->Side, side);
-            }
-
-            return side != INT_MAX ? side : SIDE_NONE;
-        };
+    for (int i = 0; i < HouseTypes.Count(); i++)
+    {
+        if (owners & (1 << i))
+            side = std::min<int>(HouseTypes[i]->Side, side);
+    }
 
-    auto isSideOwner = [](const HouseClass* house, unsigned owners) -> int
-        {
-            // The house owns the object directly
-            if (owners & 1 << house->ActLike)
-                return true;
+    return side != INT_MAX ? side : SIDE_NONE;
+}
 
-            const SideType side = house->Class->Side;
-            for (int i = 0; i < HouseTypes.Count(); i++)
-            {
-                if ((owners & 1 << i) && HouseTypes[i]->Side == side)
-                    return true;
-            }
 
-            return false;
-        };
+/**
+ *  Builds the key used to sort a sidebar icon (BuildType). Comparing two keys gives
+ *  the same result as comparing the icons field by field, in order of priority:
+ *
+ *  - Superweapons first (quickest recharge first), then infantry, aircraft, vehicles and buildings.
+ *  - Buildings: non-defenses, then walls, then gates, then base defenses (if SortDefensesAsLast is set).
+ *  - Vehicles: non-naval first.
+ *  - Objects owned by the player's side first, the rest are sorted by the first side that owns them.
+ *  - Finally, by ID.
+ *
+ *  @author: Rampastring, ZivDero, CCHyper
+ */
+static unsigned long long BuildType_Sort_Key(const SidebarClass::StripClass::BuildType &bt, unsigned side_owners)
+{
+    enum
+    {
+        BCAT_NORMAL,
+        BCAT_WALL,
+        BCAT_GATE,
+        BCAT_DEFENSE
+    };
 
+    /**
+     *  Maps a signed value to an unsigned one with the same ordering.
+     */
+    auto order = [](int value) -> unsigned long long { return unsigned(value) ^ 0x80000000U; };
 
-    const auto bt1 = static_cast<const SidebarClass::StripClass::BuildType*>(p1);
-    const auto bt2 = static_cast<const SidebarClass::StripClass::BuildType*>(p2);
+    const unsigned long long id = unsigned(bt.BuildableID) & 0xFFFFFF;
 
-    if (bt1->BuildableType == bt2->BuildableType)
+    if (bt.BuildableType == RTTI_SPECIAL || bt.BuildableType == RTTI_SUPERWEAPONTYPE)
     {
-        /**
-         *  If both are SWs, the one that recharges quicker goes first,
-         *  otherwise sort by ID.
-         */
-        if (bt1->BuildableType == RTTI_SPECIAL || bt1->BuildableType == RTTI_SUPERWEAPONTYPE)
-        {
-            if (SuperWeaponTypes[bt1->BuildableID]->RechargeTime != SuperWeaponTypes[bt2->BuildableID]->RechargeTime)
-                return SuperWeaponTypes[bt1->BuildableID]->RechargeTime - SuperWeaponTypes[bt2->BuildableID]->RechargeTime;
-
-            return bt1->BuildableID - bt2->BuildableID;
-        }
+        return (order(SuperWeaponTypes[bt.BuildableID]->RechargeTime) << 24) | id;
+    }
 
+    unsigned long long rank;
+    switch (bt.BuildableType)
+    {
+    case RTTI_INFANTRYTYPE: rank = 1; break;
+    case RTTI_AIRCRAFTTYPE: rank = 2; break;
+    case RTTI_UNITTYPE:     rank = 3; break;
+    default:                rank = 4; break;
+    }
 
-        const TechnoTypeClass* t1 = Fetch_Techno_Type(bt1->BuildableType, bt1->BuildableID);
-        const TechnoTypeClass* t2 = Fetch_Techno_Type(bt2->BuildableType, bt2->BuildableID);
+    const TechnoTypeClass* ttype = Fetch_Techno_Type(bt.BuildableType, bt.BuildableID);
+    if (!ttype)
+    {
+        return (rank << 60) | id;
+    }
 
-        /**
-         *  If both are Buildings, non-defenses come first, then walls, then gates, then base defenses
-         */
-        if (bt1->BuildableType == RTTI_BUILDINGTYPE && OptionsExtension->SortDefensesAsLast)
-        {
-            const auto b1 = static_cast<const BuildingTypeClass*>(t1), b2 = static_cast<const BuildingTypeClass*>(t2);
+    unsigned long long category = BCAT_NORMAL;
+    unsigned long long naval = 0;
 
-            const auto ext1 = Extension::Fetch(t1);
-            const auto ext2 = Extension::Fetch(t2);
+    if (bt.BuildableType == RTTI_BUILDINGTYPE && OptionsExtension->SortDefensesAsLast)
+    {
+        const auto btype = static_cast<const BuildingTypeClass*>(ttype);
 
-            enum
-            {
-                BCAT_NORMAL,
-                BCAT_WALL,
-                BCAT_GATE,
-                BCAT_DEFENSE
-            };
-
-            int building_category1 = (b1->IsWall || b1->IsFirestormWall || b1->IsLaserFencePost || b1->IsLaserFence) ? BCAT_WALL : (b1->IsGate ? BCAT_GATE : (ext1->IsSortCameoAsBaseDefense ? BCAT_DEFENSE : BCAT_NORMAL));
-            int building_category2 = (b2->IsWall || b2->IsFirestormWall || b2->IsLaserFencePost || b2->IsLaserFence) ? BCAT_WALL : (b2->IsGate ? BCAT_GATE : (ext2->IsSortCameoAsBaseDefense ? BCAT_DEFENSE : BCAT_NORMAL));
-
-            // Compare based on category priority
-            if (building_category1 != building_category2)
-                return building_category1 - building_category2;
-        }
+        if (btype->IsWall || btype->IsFirestormWall || btype->IsLaserFencePost || btype->IsLaserFence)
+            category = BCAT_WALL;
+        else if (btype->IsGate)
+            category = BCAT_GATE;
+        else if (Extension::Fetch(ttype)->IsSortCameoAsBaseDefense)
+            category = BCAT_DEFENSE;
+    }
 
-        /**
-         *  If both are Units, non-naval units come first
-         */
-        if (bt1->BuildableType == RTTI_UNITTYPE)
-        {
-            const auto ext1 = Extension::Fetch(t1);
-            const auto ext2 = Extension::Fetch(t2);
+    if (bt.BuildableType == RTTI_UNITTYPE)
+    {
+        naval = Extension::Fetch(ttype)->IsNaval ? 1 : 0;
+    }
 
-            if (ext1->IsNaval != ext2->IsNaval)
-                return static_cast<int>(ext1->IsNaval) - static_cast<int>(ext2->IsNaval);
-        }
+    const unsigned owners = ttype->Get_Ownable();
+    const bool owned = (owners & side_owners) != 0;
 
-        /**
-         *  If your side owns one of the objects, but not another, yours comes first
-         */
-        const int owns1 = isSideOwner(PlayerPtr, t1->Get_Ownable()),
-            owns2 = isSideOwner(PlayerPtr, t2->Get_Ownable());
+    /**
+     *  Objects the player owns are only sorted by ID.
+     */
+    const unsigned long long side = owned ? 0 : order(BuildType_First_Side(owners));
 
-        if (owns1 != owns2)
-            return owns2 - owns1;
+    return (rank << 60) | (category << 58) | (naval << 57) | ((owned ? 0ULL : 1ULL) << 56) | (side << 24) | id;
+}
 
-        /**
-         *  If you don't own either of the objects, then sort by side index
-         */
-        if (!owns1 && !owns2)
-        {
-            const int side1 = firstSide(t1->Get_Ownable()),
-                side2 = firstSide(t2->Get_Ownable());
 
-            if (side1 != side2)
-                return side1 - side2;
-        }
+/**
+ *  Sorts the sidebar icons (BuildTypes). The key for each icon is only built once,
+ *  rather than for every comparison.
+ *
+ *  @author: Rampastring, ZivDero, CCHyper
+ */
+static void Sort_Buildables(SidebarClass::StripClass::BuildType* buildables, int count)
+{
+    struct SortEntryStruct
+    {
+        unsigned long long Key;
+        int Index;
+    };
 
-        return bt1->BuildableID - bt2->BuildableID;
+    /**
+     *  The player owns an object if it is owned by the house they act like,
+     *  or by any house of the same side.
+     */
+    unsigned side_owners = 1 << PlayerPtr->ActLike;
+    for (int i = 0; i < HouseTypes.Count(); i++)
+    {
+        if (HouseTypes[i]->Side == PlayerPtr->Class->Side)
+            side_owners |= 1 << i;
     }
 
-    if (bt1->BuildableType == RTTI_SPECIAL || bt1->BuildableType == RTTI_SUPERWEAPONTYPE)
-        return -1;
-
-    if (bt2->BuildableType == RTTI_SPECIAL || bt2->BuildableType == RTTI_SUPERWEAPONTYPE)
-        return 1;
-
-    if (bt1->BuildableType == RTTI_INFANTRYTYPE)
-        return -1;
-
-    if (bt2->BuildableType == RTTI_INFANTRYTYPE)
-        return 1;
-
-    if (bt1->BuildableType == RTTI_AIRCRAFTTYPE)
-        return -1;
-
-    if (bt2->BuildableType == RTTI_AIRCRAFTTYPE)
-        return 1;
+    SortEntryStruct entries[SidebarClass::StripClass::MAX_BUILDABLES];
+    for (int i = 0; i < count; i++)
+    {
+        entries[i].Key = BuildType_Sort_Key(buildables[i], side_owners);
+        entries[i].Index = i;
+    }
 
-    if (bt1->BuildableType == RTTI_UNITTYPE)
-        return -1;
+    std::stable_sort(entries, entries + count, [](const SortEntryStruct& a, const SortEntryStruct& b) { return a.Key < b.Key; });
 
-    if (bt2->BuildableType == RTTI_UNITTYPE)
-        return 1;
+    SidebarClass::StripClass::BuildType sorted[SidebarClass::StripClass::MAX_BUILDABLES];
+    for (int i = 0; i < count; i++)
+    {
+        sorted[i] = buildables[entries[i].Index];
+    }
 
-    return bt1->BuildableID - bt2->BuildableID;
+    for (int i = 0; i < count; i++)
+    {
+        buildables[i] = sorted[i];
+    }
 }
 
 
@@ -1344,7 +1343,7 @@ bool StripClassExt::_Add(RTTIType type, int id)
         Buildables[BuildableCount].BuildableID = id;
         BuildableCount++;
         IsToRedraw = true;
-        qsort(&Buildables, BuildableCount, sizeof(BuildType), &BuildType_Comparison);
+        Sort_Buildables(Buildables, BuildableCount);
 
         return true;
     }
@@ -47,6 +47,12 @@
 #include "superext.h"
 #include "supertype.h"
 #include "supertypeext.h"
+#include "technoext.h"
+#include "animext.h"
+#include "memorytelemetry.h"
+#include "eventtelemetry.h"
+#include "event.h"
+#include "vinifera_newdel.h"
 #include "rules.h"
 #include "rulesext.h"
 #include "swizzle.h"
@@ -54,6 +60,21 @@
 #include "extension.h"
 #include "asserthandler.h"
 #include "debughandler.h"
+#include <Windows.h>
+
+
+unsigned char TacticalExtension::CellRedrawFlags[(MAP_CELL_W * MAP_CELL_H) / 8];
+int TacticalExtension::CellRedrawMarkedCount = 0;
+int TacticalExtension::CellRedrawFlagCount = 0;
+int TacticalExtension::StatCellsFlagged = 0;
+int TacticalExtension::StatCellsUnique = 0;
+int TacticalExtension::StatSuperTimerRows = 0;
+double TacticalExtension::StatSuperTimerTime = 0.0;
+double TacticalExtension::StatDebugOverlayTime = 0.0;
+double TacticalExtension::StatInfoTextTime = 0.0;
+int TacticalExtension::StatRallyPointLines = 0;
+int TacticalExtension::StatRallyPointRebuilds = 0;
+double TacticalExtension::StatRallyPointTime = 0.0;
 
 
 /**
@@ -75,6 +96,8 @@ TacticalExtension::TacticalExtension(const Tactical *this_ptr) :
     //if (this_ptr) EXT_DEBUG_TRACE("TacticalExtension::TacticalExtension - Name: %s (0x%08X)\n", Name(), (uintptr_t)(This()));
 
     std::memset(CellRedraw, 0, sizeof(CellRedraw));
+
+    Clear_Cell_Redraw();
 }
 
 
@@ -121,6 +144,12 @@ HRESULT TacticalExtension::Load(IStream *pStm)
     for (int i = 0; i < CellRedrawCount; i++) {
         VINIFERA_SWIZZLE_REQUEST_POINTER_REMAP(CellRedraw[i], "CellRedraw");
     }
+
+    /**
+     *  The redraw flags refer to the cells of the previous session, start
+     *  over with an empty bitmap. The loaded redraw list is not deduplicated.
+     */
+    Clear_Cell_Redraw();
     
     return hr;
 }
@@ -192,6 +221,65 @@ void TacticalExtension::Set_Info_Text(const char *text)
 }
 
 
+/**
+ *  Returns the time since "start" in microseconds, for the overlay timing statistics.
+ *
+ *  @author: CCHyper
+ */
+double TacticalExtension::Elapsed_Microseconds(const LARGE_INTEGER &start)
+{
+    LARGE_INTEGER end;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&end);
+    QueryPerformanceFrequency(&frequency);
+
+    return double(end.QuadPart - start.QuadPart) * 1000000.0 / double(frequency.QuadPart);
+}
+
+
+/**
+ *  Retained layout of the developer mode overlay. The text is only formatted
+ *  and measured again when one of the values it shows has changed.
+ */
+struct DebugOverlayLayoutStruct
+{
+    bool IsValid;
+    char ScenarioName[260];
+    int DesiredFrameRate;
+    int FramesPerSecond;
+    const ObjectClass *Object;
+    char Text[256];
+    Rect TextRect;
+
+    bool IsFrameValid;
+    int Frame;
+    char FrameText[32];
+    Rect FrameRect;
+};
+
+static DebugOverlayLayoutStruct DebugOverlayLayout;
+
+
+/**
+ *  Retained layout of the information text, only computed again when the
+ *  text, its style or position, or the tactical view size has changed.
+ */
+struct InfoTextLayoutStruct
+{
+    bool IsValid;
+    char Text[512];
+    InfoTextPosType Position;
+    TextPrintType BaseStyle;
+    Rect Tactical;
+
+    TextPrintType Style;
+    Rect FillRect;
+    Point2D TextPoint;
+};
+
+static InfoTextLayoutStruct InfoTextLayout;
+
+
 /**
  *  Draws the version number on screen for non-release builds.
  *
@@ -216,26 +304,47 @@ void TacticalExtension::Draw_Version_Number_Text()
  */
 void TacticalExtension::Draw_Debug_Overlay()
 {
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
     RGBClass rgb_black(0,0,0);
     unsigned color_black = DSurface::RGB_To_Pixel(0, 0, 0);
     ColorScheme *text_color = ColorScheme::As_Pointer("White");
 
     int padding = 2;
 
-    char buffer[256];
-    std::snprintf(buffer, sizeof(buffer),
-        "[%s] %3d %3d 0x%08X",
-        strupr(Scen->ScenarioName),
-        Session.DesiredFrameRate,
-        FramesPerSecond,
-        CurrentObjects.Count() == 1 ? CurrentObjects.Fetch_Head() : 0
-    );
+    DebugOverlayLayoutStruct &layout = DebugOverlayLayout;
 
-    /**
-     * Fetch the text occupy area.
-     */
-    Rect text_rect;
-    GradFont6Ptr->String_Pixel_Rect(buffer, &text_rect);
+    const ObjectClass *object = CurrentObjects.Count() == 1 ? CurrentObjects.Fetch_Head() : nullptr;
+
+    if (!layout.IsValid
+        || std::strncmp(layout.ScenarioName, Scen->ScenarioName, sizeof(layout.ScenarioName)-1) != 0
+        || layout.DesiredFrameRate != Session.DesiredFrameRate
+        || layout.FramesPerSecond != FramesPerSecond
+        || layout.Object != object) {
+
+        std::snprintf(layout.Text, sizeof(layout.Text),
+            "[%s] %3d %3d 0x%08X",
+            strupr(Scen->ScenarioName),
+            Session.DesiredFrameRate,
+            FramesPerSecond,
+            object
+        );
+
+        std::snprintf(layout.ScenarioName, sizeof(layout.ScenarioName), "%s", Scen->ScenarioName);
+        layout.DesiredFrameRate = Session.DesiredFrameRate;
+        layout.FramesPerSecond = FramesPerSecond;
+        layout.Object = object;
+
+        /**
+         * Fetch the text occupy area.
+         */
+        GradFont6Ptr->String_Pixel_Rect(layout.Text, &layout.TextRect);
+
+        layout.IsValid = true;
+    }
+
+    Rect text_rect = layout.TextRect;
 
     /**
      *  Fill the background area.
@@ -258,14 +367,20 @@ void TacticalExtension::Draw_Debug_Overlay()
     /**
      *  Draw the overlay text.
      */
-    Fancy_Text_Print(buffer, CompositeSurface, &CompositeSurface->Get_Rect(),
+    Fancy_Text_Print(layout.Text, CompositeSurface, &CompositeSurface->Get_Rect(),
         &Point2D(text_rect.X, text_rect.Y), text_color, COLOR_TBLACK, TextPrintType(TPF_6PT_GRAD|TPF_NOSHADOW));
 
     /**
      *  Draw the current frame number.
      */
-    std::snprintf(buffer, sizeof(buffer), "%d", Frame);
-    GradFont6Ptr->String_Pixel_Rect(buffer, &text_rect);
+    if (!layout.IsFrameValid || layout.Frame != Frame) {
+        std::snprintf(layout.FrameText, sizeof(layout.FrameText), "%d", Frame);
+        GradFont6Ptr->String_Pixel_Rect(layout.FrameText, &layout.FrameRect);
+        layout.Frame = Frame;
+        layout.IsFrameValid = true;
+    }
+
+    text_rect = layout.FrameRect;
 
     fill_rect.Width = text_rect.Width+(padding+1);
     fill_rect.Height = 16;
@@ -278,8 +393,10 @@ void TacticalExtension::Draw_Debug_Overlay()
     text_rect.Width += padding;
     text_rect.Height += 3;
 
-    Fancy_Text_Print(buffer, CompositeSurface, &CompositeSurface->Get_Rect(),
+    Fancy_Text_Print(layout.FrameText, CompositeSurface, &CompositeSurface->Get_Rect(),
         &Point2D(text_rect.X, text_rect.Y), text_color, COLOR_TBLACK, TextPrintType(TPF_RIGHT|TPF_6PT_GRAD|TPF_NOSHADOW));
+
+    StatDebugOverlayTime = Elapsed_Microseconds(start);
 }
 
 
@@ -396,13 +513,59 @@ void TacticalExtension::Draw_FrameStep_Overlay()
 void TacticalExtension::Draw_Information_Text()
 {
     if (!IsInfoTextSet) {
+        StatInfoTextTime = 0.0;
         return;
     }
 
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
     RGBClass rgb_black(0,0,0);
-    unsigned color_black = DSurface::RGB_To_Pixel(0, 0, 0);
     ColorScheme *text_color = ColorScheme::As_Pointer("White");
 
+    const char *text = InfoTextBuffer;
+
+    InfoTextLayoutStruct &layout = InfoTextLayout;
+
+    if (!layout.IsValid
+        || std::strncmp(layout.Text, text, sizeof(layout.Text)-1) != 0
+        || layout.Position != InfoTextPosition
+        || layout.BaseStyle != InfoTextStyle
+        || layout.Tactical.X != TacticalRect.X || layout.Tactical.Y != TacticalRect.Y
+        || layout.Tactical.Width != TacticalRect.Width || layout.Tactical.Height != TacticalRect.Height) {
+
+        std::snprintf(layout.Text, sizeof(layout.Text), "%s", text);
+        layout.Position = InfoTextPosition;
+        layout.BaseStyle = InfoTextStyle;
+        layout.Tactical = TacticalRect;
+
+        Layout_Information_Text(layout.FillRect, layout.TextPoint, layout.Style);
+
+        layout.IsValid = true;
+    }
+
+    /**
+     *  Fill the background area.
+     */
+    CompositeSurface->Fill_Rect_Trans(layout.FillRect, rgb_black, 50);
+
+    /**
+     *  Draw the overlay text.
+     */
+    Fancy_Text_Print(text, CompositeSurface, &CompositeSurface->Get_Rect(),
+        &layout.TextPoint, text_color, COLOR_TBLACK, layout.Style);
+
+    StatInfoTextTime = Elapsed_Microseconds(start);
+}
+
+
+/**
+ *  Computes the background and text position of the information text.
+ * 
+ *  @author: CCHyper
+ */
+void TacticalExtension::Layout_Information_Text(Rect &fill_rect, Point2D &text_point, TextPrintType &text_style) const
+{
     int padding = 2;
 
     const char *text = InfoTextBuffer;
@@ -413,8 +576,6 @@ void TacticalExtension::Draw_Information_Text()
     Rect text_rect;
     GradFont6Ptr->String_Pixel_Rect(text, &text_rect);
 
-    Rect fill_rect;
-
     TextPrintType style = InfoTextStyle;
     int pos_x = 0;
     int pos_y = 0;
@@ -503,16 +664,8 @@ void TacticalExtension::Draw_Information_Text()
 
     };
 
-    /**
-     *  Fill the background area.
-     */
-    CompositeSurface->Fill_Rect_Trans(fill_rect, rgb_black, 50);
-
-    /**
-     *  Draw the overlay text.
-     */
-    Fancy_Text_Print(text, CompositeSurface, &CompositeSurface->Get_Rect(),
-        &Point2D(text_rect.X, text_rect.Y), text_color, COLOR_TBLACK, style);
+    text_point = Point2D(text_rect.X, text_rect.Y);
+    text_style = style;
 }
 
 
@@ -539,6 +692,30 @@ void TacticalExtension::Render_Post()
 }
 
 
+/**
+ *  The maximum number of super weapon timer rows whose text is cached.
+ */
+#define SUPER_TIMER_MAX_ROWS 64
+
+
+/**
+ *  The formatted and measured text of a super weapon timer row. The text only
+ *  changes when the displayed second or the super weapon changes, so it is
+ *  kept between renders rather than being formatted and measured every time.
+ */
+struct SuperTimerRowStruct
+{
+    bool IsValid;
+    int Time;
+    char NameBuff[128];
+    char TimerBuff[128];
+    Rect NameRect;
+    Rect TimerRect;
+};
+
+static SuperTimerRowStruct SuperTimerRows[SUPER_TIMER_MAX_ROWS];
+
+
 /**
  *  Prints a single super weapon timer to the tactical screen.
  * 
@@ -554,29 +731,39 @@ void TacticalExtension::Super_Draw_Timer(int row_index, ColorScheme *color, int
         _font = Font_Ptr(style);
     }
 
-    char fullbuff[128];
-    char namebuff[128];
-    char timerbuff[128];
-    int text_width = -1;
     int flash_delay = 500; // was 1000
     bool to_flash = false;
-    unsigned color_black = DSurface::RGB_To_Pixel(0, 0, 0);
     RGBClass rgb_black(0, 0, 0);
-    ColorScheme *white_color = ColorScheme::As_Pointer("White", 1);
     int background_tint = 50;
 
     long hours = (time / 60 / 60);
     long seconds = (time % 60);
     long minutes = (time / 60 % 60);
 
-    if (hours) {
-        std::snprintf(fullbuff, sizeof(fullbuff), "%s %d:%02d:%02d", name, hours, minutes, seconds);
-        std::snprintf(namebuff, sizeof(namebuff), "%s", name);
-        std::snprintf(timerbuff, sizeof(timerbuff), "%d:%02d:%02d", hours, minutes, seconds);
-    } else {
-        std::snprintf(fullbuff, sizeof(fullbuff), "%s %02d:%02d", name, minutes, seconds);
-        std::snprintf(namebuff, sizeof(namebuff), "%s", name);
-        std::snprintf(timerbuff, sizeof(timerbuff), "%02d:%02d", minutes, seconds);
+    /**
+     *  Fetch the cached text for this row, the rows past the end
+     *  of the cache use a temporary entry.
+     */
+    SuperTimerRowStruct temp_row;
+    temp_row.IsValid = false;
+
+    SuperTimerRowStruct &row = row_index < SUPER_TIMER_MAX_ROWS ? SuperTimerRows[row_index] : temp_row;
+
+    if (!row.IsValid || row.Time != time || std::strncmp(row.NameBuff, name, sizeof(row.NameBuff)-1) != 0) {
+
+        if (hours) {
+            std::snprintf(row.NameBuff, sizeof(row.NameBuff), "%s", name);
+            std::snprintf(row.TimerBuff, sizeof(row.TimerBuff), "%d:%02d:%02d", hours, minutes, seconds);
+        } else {
+            std::snprintf(row.NameBuff, sizeof(row.NameBuff), "%s", name);
+            std::snprintf(row.TimerBuff, sizeof(row.TimerBuff), "%02d:%02d", minutes, seconds);
+        }
+
+        _font->String_Pixel_Rect(row.NameBuff, &row.NameRect);
+        _font->String_Pixel_Rect(row.TimerBuff, &row.TimerRect);
+
+        row.Time = time;
+        row.IsValid = true;
     }
 
     /**
@@ -592,13 +779,9 @@ void TacticalExtension::Super_Draw_Timer(int row_index, ColorScheme *color, int
         }
     }
 
-    Rect name_rect;
-    _font->String_Pixel_Rect(namebuff, &name_rect);
+    const Rect &name_rect = row.NameRect;
+    const Rect &timer_rect = row.TimerRect;
 
-    Rect timer_rect;
-    _font->String_Pixel_Rect(timerbuff, &timer_rect);
-
-    int font_width = _font->Get_Font_Width();
     int font_height = _font->Get_Font_Height();
 
     int y_pos = TacticalRect.Height - (row_index * (font_height + 2)) + 3;
@@ -622,10 +805,13 @@ void TacticalExtension::Super_Draw_Timer(int row_index, ColorScheme *color, int
     //CompositeSurface->Fill_Rect(CompositeSurface->Get_Rect(), fill_rect, color_black);
     CompositeSurface->Fill_Rect_Trans(fill_rect, rgb_black, background_tint);
 
-    Fancy_Text_Print(timerbuff, CompositeSurface, &CompositeSurface->Get_Rect(), 
-        &timer_point, to_flash ? white_color : color, COLOR_TBLACK, style);
+    /**
+     *  The white color scheme is looked up by name, so only do it when it is needed.
+     */
+    Fancy_Text_Print(row.TimerBuff, CompositeSurface, &CompositeSurface->Get_Rect(), 
+        &timer_point, to_flash ? ColorScheme::As_Pointer("White", 1) : color, COLOR_TBLACK, style);
 
-    Fancy_Text_Print(namebuff, CompositeSurface, &CompositeSurface->Get_Rect(), 
+    Fancy_Text_Print(row.NameBuff, CompositeSurface, &CompositeSurface->Get_Rect(), 
         &name_point, color, COLOR_TBLACK, style);
 }
 
@@ -639,6 +825,9 @@ void TacticalExtension::Draw_Super_Timers()
 {
     //EXT_DEBUG_TRACE("TacticalExtension::Draw_Super_Timers - 0x%08X\n", (uintptr_t)(This()));
 
+    StatSuperTimerRows = 0;
+    StatSuperTimerTime = 0.0;
+
     /**
      *  Super weapon timers are for multiplayer only.
      */
@@ -671,6 +860,10 @@ void TacticalExtension::Draw_Super_Timers()
 #else
     int row_index = 3;
 #endif
+    const int first_row = row_index;
+
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
 
     /**
      *  Iterate over all active super weapons and print their recharge timers.
@@ -712,20 +905,235 @@ void TacticalExtension::Draw_Super_Timers()
         }
 
     }
+
+    StatSuperTimerRows = row_index - first_row;
+    StatSuperTimerTime = Elapsed_Microseconds(start);
 }
 
 
 /**
  *  Adds a cell to the to-redraw list.
  *
- *  @author: ZivDero
+ *  @author: ZivDero, CCHyper
  *
  *  @note: Do not use this function by itself! Call Tactical::Flag_Cell instead.
  */
 void TacticalExtension::Flag_Cell(CellClass& cell)
 {
-    if (TacticalMap->CellRedrawCount < std::size(CellRedraw) - 1) { // -1 because... reasons. It's that way in vanilla.
-        CellRedraw[TacticalMap->CellRedrawCount] = &cell;
-        TacticalMap->CellRedrawCount++;
+    /**
+     *  The render process resets the redraw count once it has consumed the list,
+     *  so use this to detect the start of a new list and clear the previous flags.
+     */
+    if (TacticalMap->CellRedrawCount == 0 && (CellRedrawMarkedCount > 0 || CellRedrawFlagCount > 0)) {
+        Reset_Cell_Redraw();
+    }
+
+    ++CellRedrawFlagCount;
+
+    /**
+     *  Skip cells that are already in the redraw list, the render procedures would
+     *  otherwise draw them multiple times.
+     */
+    const Cell &cellid = cell.CellID;
+    if (cellid.X < 0 || cellid.X >= MAP_CELL_W || cellid.Y < 0 || cellid.Y >= MAP_CELL_H) {
+        return;
+    }
+
+    const int index = (cellid.Y * MAP_CELL_W) + cellid.X;
+    const unsigned char mask = (1 << (index & 7));
+
+    if (CellRedrawFlags[index >> 3] & mask) {
+        return;
+    }
+
+    if (TacticalMap->CellRedrawCount >= std::size(CellRedraw) - 1) { // -1 because... reasons. It's that way in vanilla.
+
+        /**
+         *  The list is full, redraw the whole view rather than dropping the cell.
+         */
+        TacticalMap->IsToRedraw = true;
+        return;
+    }
+
+    CellRedrawFlags[index >> 3] |= mask;
+
+    CellRedraw[TacticalMap->CellRedrawCount] = &cell;
+    TacticalMap->CellRedrawCount++;
+
+    CellRedrawMarkedCount = TacticalMap->CellRedrawCount;
+}
+
+
+/**
+ *  Clears the redraw flags of the consumed redraw list.
+ *
+ *  @author: CCHyper
+ */
+void TacticalExtension::Reset_Cell_Redraw()
+{
+    /**
+     *  Record the statistics of the list we are about to discard.
+     */
+    StatCellsFlagged = CellRedrawFlagCount;
+    StatCellsUnique = CellRedrawMarkedCount;
+
+    /**
+     *  Only the cells that are in the list have their flag set, so clearing
+     *  these is much cheaper than clearing the whole bitmap.
+     */
+    for (int i = 0; i < CellRedrawMarkedCount; ++i) {
+        const CellClass *cell = CellRedraw[i];
+        if (cell) {
+            const int index = (cell->CellID.Y * MAP_CELL_W) + cell->CellID.X;
+            CellRedrawFlags[index >> 3] &= ~(1 << (index & 7));
+        }
+    }
+
+    CellRedrawMarkedCount = 0;
+    CellRedrawFlagCount = 0;
+}
+
+
+/**
+ *  Clears all the redraw flags and statistics, for when a new
+ *  game is started or a saved game is loaded.
+ *
+ *  @author: CCHyper
+ */
+void TacticalExtension::Clear_Cell_Redraw()
+{
+    std::memset(CellRedrawFlags, 0, sizeof(CellRedrawFlags));
+
+    CellRedrawMarkedCount = 0;
+    CellRedrawFlagCount = 0;
+
+    StatCellsFlagged = 0;
+    StatCellsUnique = 0;
+}
+
+
+/**
+ *  Prints a single line of the developer statistics overlay.
+ *
+ *  @author: CCHyper
+ */
+void TacticalExtension::Draw_Statistics_Line(int row_index, const char *text)
+{
+    unsigned color_black = DSurface::RGB_To_Pixel(0, 0, 0);
+    ColorScheme *text_color = ColorScheme::As_Pointer("White");
+
+    int padding = 2;
+    int row_height = GradFont6Ptr->Get_Font_Height() + 2;
+
+    /**
+     * Fetch the text occupy area.
+     */
+    Rect text_rect;
+    GradFont6Ptr->String_Pixel_Rect(text, &text_rect);
+
+    /**
+     *  Fill the background area.
+     */
+    Rect fill_rect;
+    fill_rect.X = TacticalRect.X;
+    fill_rect.Y = TacticalRect.Y + (row_index * row_height);
+    fill_rect.Width = text_rect.Width+(padding+1);
+    fill_rect.Height = row_height;
+    CompositeSurface->Fill_Rect(fill_rect, color_black);
+
+    /**
+     *  Draw the overlay text.
+     */
+    Fancy_Text_Print(text, CompositeSurface, &CompositeSurface->Get_Rect(),
+        &Point2D(fill_rect.X+padding, fill_rect.Y), text_color, COLOR_TBLACK, TextPrintType(TPF_6PT_GRAD|TPF_NOSHADOW));
+}
+
+
+/**
+ *  Draws the developer statistics overlay.
+ *
+ *  @author: CCHyper
+ */
+void TacticalExtension::Draw_Statistics_Overlay()
+{
+    char buffer[256];
+    int row_index = 0;
+
+    std::snprintf(buffer, sizeof(buffer), "Cells: %d flagged, %d unique",
+        StatCellsFlagged, StatCellsUnique);
+    Draw_Statistics_Line(row_index++, buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Passive acquire scans: %d",
+        TechnoClassExtension::Passive_Acquire_Scans_Last_Frame());
+    Draw_Statistics_Line(row_index++, buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Overlays: debug %.0f us, info text %.0f us",
+        StatDebugOverlayTime, StatInfoTextTime);
+    Draw_Statistics_Line(row_index++, buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Rally points: %d lines, %d rebuilt, %.0f us",
+        StatRallyPointLines, StatRallyPointRebuilds, StatRallyPointTime);
+    Draw_Statistics_Line(row_index++, buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Super weapon timers: %d rows, %.0f us",
+        StatSuperTimerRows, StatSuperTimerTime);
+    Draw_Statistics_Line(row_index++, buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Anim logic: %d anims, %.0f us",
+        AnimClassExtension::AI_Count_Last_Frame(), AnimClassExtension::AI_Time_Last_Frame());
+    Draw_Statistics_Line(row_index++, buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Memory: %u KB live, %u KB peak, %d allocs, %d frees",
+        Vinifera_Allocated_Bytes / 1024, Vinifera_Allocated_Bytes_Peak / 1024,
+        MemoryTelemetry::Allocations_Last_Frame(), MemoryTelemetry::Frees_Last_Frame());
+    Draw_Statistics_Line(row_index++, buffer);
+
+    /**
+     *  Per heap table, only listing heaps that have been used so far.
+     */
+    Draw_Statistics_Line(row_index++, "Heap: count / KB / net growth / peak");
+
+    for (int i = 0; i < MemoryTelemetry::Entry_Count(); ++i) {
+        const TelemetryEntry &entry = MemoryTelemetry::Entry(i);
+        if (!entry.Peak) {
+            continue;
+        }
+        std::snprintf(buffer, sizeof(buffer), "  %s: %d / %d / %d / %d",
+            entry.Name, entry.Count, entry.Bytes / 1024, entry.Growth, entry.Peak);
+        Draw_Statistics_Line(row_index++, buffer);
+    }
+
+    if (!EventTelemetry::Is_Enabled()) {
+        return;
+    }
+
+    /**
+     *  Event queue table, only listing event types and houses seen so far.
+     */
+    Draw_Statistics_Line(row_index++, "Event: count / avg delay / max delay / avg ms / avg us / max us");
+
+    for (int i = 0; i < EVENT_TELEMETRY_MAX_TYPES; ++i) {
+        const EventTypeTelemetry &entry = EventTelemetry::Type_Entry(i);
+        if (!entry.Count) {
+            continue;
+        }
+        std::snprintf(buffer, sizeof(buffer), "  %s: %d / %.1f / %d / %.1f / %.1f / %.1f",
+            EventClass::Event_Name(EventType(i)), entry.Count,
+            entry.LatencyCount ? float(entry.TotalDelay) / entry.LatencyCount : 0.0f, entry.MaxDelay,
+            entry.LatencyCount ? float(entry.TotalDelayMs) / entry.LatencyCount : 0.0f,
+            entry.TimedCount ? float(entry.TotalTime / entry.TimedCount) : 0.0f, float(entry.MaxTime));
+        Draw_Statistics_Line(row_index++, buffer);
+    }
+
+    Draw_Statistics_Line(row_index++, "House events: count / bytes / per second");
+
+    for (int i = 0; i < EVENT_TELEMETRY_MAX_HOUSES && i < Houses.Count(); ++i) {
+        const HouseEventTelemetry &entry = EventTelemetry::House_Entry(i);
+        if (!entry.Count) {
+            continue;
+        }
+        std::snprintf(buffer, sizeof(buffer), "  %s: %d / %d / %d",
+            Houses[i]->IniName, entry.Count, entry.Bytes, entry.Rate);
+        Draw_Statistics_Line(row_index++, buffer);
     }
 }
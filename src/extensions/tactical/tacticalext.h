@@ -35,6 +35,7 @@
 #include "wstring.h"
 #include "point.h"
 #include "textprint.h"
+#include "tibsun_defines.h"
 #include <objidl.h>
 
 
@@ -77,16 +78,24 @@ class TacticalExtension final : public GlobalExtensionClass<Tactical>
 
         void Draw_Information_Text();
         void Draw_Super_Timers();
+        void Draw_Statistics_Overlay();
 
         void Render_Post();
         void Flag_Cell(CellClass& cell);
 
+        static double Elapsed_Microseconds(const LARGE_INTEGER &start);
+
 #ifndef NDEBUG
         bool Debug_Draw_Facings();
 #endif
 
     private:
         void Super_Draw_Timer(int row_index, ColorScheme *color, int time, const char *name, unsigned long *flash_time, bool *flash_state);
+        void Draw_Statistics_Line(int row_index, const char *text);
+        void Layout_Information_Text(Rect &fill_rect, Point2D &text_point, TextPrintType &text_style) const;
+
+        void Reset_Cell_Redraw();
+        static void Clear_Cell_Redraw();
 
     public:
         /**
@@ -133,4 +142,51 @@ class TacticalExtension final : public GlobalExtensionClass<Tactical>
          *  The number of cells in the array above, only used after loading the game!
          */
         int CellRedrawCount;
+
+        /**
+         *  Bitmap of the cells currently in the redraw list, indexed by cell number.
+         *  A cell is only ever added to the list once until the list is consumed.
+         *
+         *  @note: This and the redraw state below are transient and are not saved,
+         *         they are cleared when a game is started or loaded.
+         */
+        static unsigned char CellRedrawFlags[(MAP_CELL_W * MAP_CELL_H) / 8];
+
+        /**
+         *  The number of cells we have marked in the bitmap above.
+         */
+        static int CellRedrawMarkedCount;
+
+        /**
+         *  The number of times Flag_Cell was called for the current redraw list.
+         */
+        static int CellRedrawFlagCount;
+
+        /**
+         *  Redraw statistics of the last completed redraw list, for the developer overlay.
+         */
+        static int StatCellsFlagged;
+        static int StatCellsUnique;
+
+        /**
+         *  Super weapon timer rows drawn on the last render, and the time taken
+         *  to draw them in microseconds, for the developer overlay.
+         */
+        static int StatSuperTimerRows;
+        static double StatSuperTimerTime;
+
+        /**
+         *  Time taken to draw the developer and information text overlays
+         *  on the last render, in microseconds.
+         */
+        static double StatDebugOverlayTime;
+        static double StatInfoTextTime;
+
+        /**
+         *  Rally point lines drawn on the last render, how many of them had their
+         *  cached geometry rebuilt, and the time taken to draw them in microseconds.
+         */
+        static int StatRallyPointLines;
+        static int StatRallyPointRebuilds;
+        static double StatRallyPointTime;
 };
@@ -53,6 +53,7 @@
 #include "buildingtype.h"
 
 #include <timeapi.h>
+#include <vector>
 
 #include "clipline.h"
 #include "hooker.h"
@@ -88,11 +89,18 @@ public:
     static bool SelectionContainsNonCombatants;
     static int SelectedCount;
     static bool FilterSelection;
+
+    /**
+     *  State of the ALT key when the selection started, so the key
+     *  isn't polled again for every object in the band box.
+     */
+    static bool IsAltDown;
 };
 
 bool TacticalExt::SelectionContainsNonCombatants = false;
 int TacticalExt::SelectedCount = 0;
 bool TacticalExt::FilterSelection = false;
+bool TacticalExt::IsAltDown = false;
 
 
 /**
@@ -275,10 +283,32 @@ static bool Should_Exclude_From_Selection(ObjectClass* obj)
 }
 
 
+/**
+ *  Scratch lists for Filter_Selection, kept between calls so large
+ *  selections don't reallocate them every time.
+ */
+static std::vector<ObjectClass*> FilterExcluded;
+static std::vector<ObjectClass*> FilterKept;
+
+
+/**
+ *  Empties CurrentObjects from the end, which does not shift any entries
+ *  and keeps the allocated list for reuse.
+ *
+ *  @author: CCHyper
+ */
+static void Truncate_Current_Objects()
+{
+    while (CurrentObjects.Count() > 0) {
+        CurrentObjects.Delete(CurrentObjects.Count() - 1);
+    }
+}
+
+
 /**
  *  Filters the selection from any non-combatants.
  *  
- *  @author: Petroglyph (Remaster), Rampastring, ZivDero
+ *  @author: Petroglyph (Remaster), Rampastring, ZivDero, CCHyper
  */
 static void Filter_Selection()
 {
@@ -286,27 +316,44 @@ static void Filter_Selection()
         return;
     }
 
-    bool any_to_exclude = false;
-    bool all_to_exclude = true;
+    /**
+     *  Classify the whole selection in a single pass.
+     */
+    FilterExcluded.clear();
+    FilterKept.clear();
 
     for (int i = 0; i < CurrentObjects.Count(); i++) {
-        const bool exclude = Should_Exclude_From_Selection(CurrentObjects[i]);
-        any_to_exclude |= exclude;
-        all_to_exclude &= exclude;
+        if (Should_Exclude_From_Selection(CurrentObjects[i])) {
+            FilterExcluded.push_back(CurrentObjects[i]);
+        } else {
+            FilterKept.push_back(CurrentObjects[i]);
+        }
+    }
+
+    if (FilterExcluded.empty() || FilterKept.empty()) {
+        return;
     }
 
-    if (any_to_exclude && !all_to_exclude) {
-        for (int i = 0; i < CurrentObjects.Count(); i++) {
-            if (Should_Exclude_From_Selection(CurrentObjects[i])) {
+    /**
+     *  Unselecting an object removes it from CurrentObjects, shifting everything
+     *  after it down, so unselecting many objects from a large selection is quadratic.
+     *  Order the list with the kept objects first, followed by the excluded objects in
+     *  reverse, so each excluded object is the last entry when it is unselected and
+     *  nothing has to be shifted. The selection callbacks still see every kept object
+     *  and every excluded object that has not been unselected yet.
+     */
+    Truncate_Current_Objects();
 
-                const int count_before = CurrentObjects.Count();
-                CurrentObjects[i]->Unselect();
-                const int count_after = CurrentObjects.Count();
-                if (count_after < count_before) {
-                    i--;
-                }
-            }
-        }
+    for (ObjectClass* obj : FilterKept) {
+        CurrentObjects.Add(obj);
+    }
+
+    for (auto it = FilterExcluded.rbegin(); it != FilterExcluded.rend(); ++it) {
+        CurrentObjects.Add(*it);
+    }
+
+    for (ObjectClass* obj : FilterExcluded) {
+        obj->Unselect();
     }
 }
 
@@ -338,6 +385,7 @@ void TacticalExt::_Select_These(Rect& rect, void (*selection_func)(ObjectClass*
     SelectionContainsNonCombatants = Has_NonCombatants_Selected();
     SelectedCount = CurrentObjects.Count();
     FilterSelection = false;
+    IsAltDown = WWKeyboard->Down(VK_ALT);
 
     AllowVoice = true;
 
@@ -438,7 +486,7 @@ static void Vinifera_Bandbox_Select(ObjectClass* obj)
      const TechnoClass* techno = Target_As_Techno(obj);
      if (techno && OptionsExtension->FilterBandBoxSelection
          && TacticalExt::SelectedCount > 0 && !TacticalExt::SelectionContainsNonCombatants
-         && !WWKeyboard->Down(VK_ALT))
+         && !TacticalExt::IsAltDown)
      {
          const auto ext = Extension::Fetch(techno->TClass);
          if (ext->IsFilterFromBandBoxSelection)
@@ -452,12 +500,107 @@ static void Vinifera_Bandbox_Select(ObjectClass* obj)
         /**
          *  If this is a new selection, filter it at the end.
          */
-        if (TacticalExt::SelectedCount == 0 && !WWKeyboard->Down(VK_ALT))
+        if (TacticalExt::SelectedCount == 0 && !TacticalExt::IsAltDown)
             TacticalExt::FilterSelection = true;
     }
 }
 
 
+/**
+ *  The number of lines drawn for each rally point; the drop shadow and
+ *  the two lines that make up the thickened rally line.
+ */
+#define RALLY_POINT_LINE_COUNT 3
+
+
+/**
+ *  Cached screen geometry of a single rally point line.
+ */
+struct RallyPointLineStruct
+{
+    /**
+     *  The building and rally point this geometry was computed for.
+     */
+    const BuildingClass *Building;
+    Coord CenterCoord;
+    TARGET Target;
+    Coord TargetCoord;
+    bool IsUnderBridge;
+
+    /**
+     *  The clipped line segments, in the order they are drawn.
+     */
+    Point2D Start[RALLY_POINT_LINE_COUNT];
+    Point2D End[RALLY_POINT_LINE_COUNT];
+    bool IsVisible[RALLY_POINT_LINE_COUNT];
+};
+
+
+/**
+ *  The rally point geometry of the selected buildings, in selection order, and
+ *  the viewport it was clipped against. The selection order rarely changes
+ *  between renders, so entries are matched by their position in the list.
+ */
+static std::vector<RallyPointLineStruct> RallyPointLines;
+static Rect RallyPointTacticalRect;
+static Point2D RallyPointViewport;
+
+
+/**
+ *  Projects and clips the rally point line of a building to the tactical view.
+ *
+ *  @author: ZivDero, CCHyper
+ */
+static void Build_Rally_Point_Line(RallyPointLineStruct &line, const Point2D &offset, const Coord &rally_center)
+{
+    /**
+     *  The start of the line is just at the building's center.
+     */
+    Point2D start_pos = TacticalMap->func_60F150(line.CenterCoord);
+    start_pos += offset;
+
+    /**
+     *  Get the coordinate of the rally point and adjust it for cell height.
+     */
+    Coord rally_coord = rally_center;
+
+    rally_coord.Z = Map.Get_Height_GL(rally_coord);
+    if (line.IsUnderBridge)
+        rally_coord.Z += BRIDGE_LEPTON_HEIGHT;
+
+    Point2D end_pos = TacticalMap->func_60F0F0(Point2D(rally_coord.X, rally_coord.Y)) / 256;
+    end_pos.Y -= Z_Lepton_To_Pixel(rally_coord.Z);
+    end_pos += offset;
+
+    /**
+     *  #issue-351
+     *
+     *  Thicken the rally point lines so they are easier to see in contrast to the terrain.
+     *  The drop shadow line is two pixels down, followed by two lines offset by one pixel
+     *  from each other, giving the impression that it is double the thickness.
+     *
+     *  Each line continues from the clipped end points of the previous one, as
+     *  the lines have always been drawn.
+     *
+     *  @authors: CCHyper
+     */
+    start_pos.Y += 2;
+    end_pos.Y += 2;
+
+    for (int i = 0; i < RALLY_POINT_LINE_COUNT; ++i)
+    {
+        if (i > 0) {
+            --start_pos.Y;
+            --end_pos.Y;
+        }
+
+        line.IsVisible[i] = Clip_Line(start_pos, end_pos, TacticalMap->TacticalRect);
+        line.Start[i] = start_pos;
+        line.End[i] = end_pos;
+    }
+}
+
+
 /**
  *  Rally point line drawing routine replacement.
  *
@@ -470,6 +613,13 @@ void TacticalExt::_Draw_Rally_Points(bool blit)
      */
     static bool _pattern[16] = { true, true, true, true, true, false, false, false, true, true, true, true, true, false, false, false };
 
+    const bool show_stats = Vinifera_DeveloperMode && Vinifera_Developer_ShowStatistics;
+
+    LARGE_INTEGER start;
+    if (show_stats) {
+        QueryPerformanceCounter(&start);
+    }
+
     /**
      *  #issue-348
      *
@@ -485,6 +635,24 @@ void TacticalExt::_Draw_Rally_Points(bool blit)
     const unsigned color = DSurface::RGB_To_Pixel(0, 255, 0);
     const unsigned color_black = DSurface::RGB_To_Pixel(0, 0, 0);
 
+    /**
+     *  The clipped lines depend on the viewport, so if it has scrolled
+     *  all the cached geometry needs to be rebuilt.
+     */
+    const Point2D viewport_offset = Point2D(TacticalRect.X, TacticalRect.Y) - field_5C;
+
+    if (TacticalRect.X != RallyPointTacticalRect.X || TacticalRect.Y != RallyPointTacticalRect.Y
+     || TacticalRect.Width != RallyPointTacticalRect.Width || TacticalRect.Height != RallyPointTacticalRect.Height
+     || field_5C.X != RallyPointViewport.X || field_5C.Y != RallyPointViewport.Y)
+    {
+        RallyPointLines.clear();
+        RallyPointTacticalRect = TacticalRect;
+        RallyPointViewport = field_5C;
+    }
+
+    int line_count = 0;
+    int rebuild_count = 0;
+
     /**
      *  Iterate all selected objects to see if we need to draw a rally point line for them.
      */
@@ -504,65 +672,59 @@ void TacticalExt::_Draw_Rally_Points(bool blit)
                  */
                 if (Target_Legal(bldg->ArchiveTarget) && bldg->Get_Mission() != MISSION_DECONSTRUCTION)
                 {
-                    /**
-                     *  The start of the line is just at the building's center.
-                     */
-                    Coord center_coord = bldg->Center_Coord();
-                    Point2D start_pos = func_60F150(center_coord);
-                    start_pos += Point2D(TacticalRect.X, TacticalRect.Y) - field_5C;
+                    const Coord center_coord = bldg->Center_Coord();
+                    const Coord rally_coord = bldg->ArchiveTarget->Center_Coord();
+                    const bool under_bridge = Map[rally_coord].IsUnderBridge;
 
-                    /**
-                     *  Get the coordinate of the rally point and adjust it for cell height.
-                     */
-                    Coord rally_coord = bldg->ArchiveTarget->Center_Coord();
-
-                    rally_coord.Z = Map.Get_Height_GL(rally_coord);
-                    if (Map[rally_coord].IsUnderBridge)
-                        rally_coord.Z += BRIDGE_LEPTON_HEIGHT;
-
-                    Point2D end_pos = func_60F0F0(Point2D(rally_coord.X, rally_coord.Y)) / 256;
-                    end_pos.Y -= Z_Lepton_To_Pixel(rally_coord.Z);
-                    end_pos += Point2D(TacticalRect.X, TacticalRect.Y) - field_5C;
-
-                    /**
-                     *  #issue-351
-                     *
-                     *  Thicken the rally point lines so they are easier to see in contrast to the terrain.
-                     *
-                     *  @authors: CCHyper
-                     */
+                    if (line_count >= (int)RallyPointLines.size()) {
+                        RallyPointLines.emplace_back();
+                        RallyPointLines.back().Building = nullptr;
+                    }
 
                     /**
-                     *  Draw the drop shadow line.
+                     *  Only project the line again if the building, its rally point
+                     *  or the bridge over the rally point has changed.
                      */
-                    start_pos.Y += 2;
-                    end_pos.Y += 2;
-                    if (Clip_Line(start_pos, end_pos, TacticalRect))
+                    RallyPointLineStruct &line = RallyPointLines[line_count++];
+                    if (line.Building != bldg || line.Target != bldg->ArchiveTarget
+                     || line.CenterCoord != center_coord || line.TargetCoord != rally_coord
+                     || line.IsUnderBridge != under_bridge)
                     {
-                        LogicSurface->entry_48(start_pos, end_pos, color_black, _pattern, offset, blit);
+                        line.Building = bldg;
+                        line.CenterCoord = center_coord;
+                        line.Target = bldg->ArchiveTarget;
+                        line.TargetCoord = rally_coord;
+                        line.IsUnderBridge = under_bridge;
+
+                        Build_Rally_Point_Line(line, viewport_offset, rally_coord);
+                        ++rebuild_count;
                     }
 
                     /**
-                     *  Draw two lines, offset by one pixel from each other, giving the
-                     *  impression that it is double the thickness.
+                     *  Submit the drop shadow line, then the two green lines.
                      */
-                    --start_pos.Y;
-                    --end_pos.Y;
-                    if (Clip_Line(start_pos, end_pos, TacticalRect))
-                    {
-                        LogicSurface->entry_48(start_pos, end_pos, color, _pattern, offset, blit);
-                    }
-
-                    --start_pos.Y;
-                    --end_pos.Y;
-                    if (Clip_Line(start_pos, end_pos, TacticalRect))
+                    for (int j = 0; j < RALLY_POINT_LINE_COUNT; ++j)
                     {
-                        LogicSurface->entry_48(start_pos, end_pos, color, _pattern, offset, blit);
+                        if (line.IsVisible[j])
+                        {
+                            LogicSurface->entry_48(line.Start[j], line.End[j], j == 0 ? color_black : color, _pattern, offset, blit);
+                        }
                     }
                 }
             }
         }
     }
+
+    /**
+     *  Drop the geometry of buildings that are no longer selected.
+     */
+    RallyPointLines.resize(line_count);
+
+    if (show_stats) {
+        TacticalExtension::StatRallyPointLines = line_count;
+        TacticalExtension::StatRallyPointRebuilds = rebuild_count;
+        TacticalExtension::StatRallyPointTime = TacticalExtension::Elapsed_Microseconds(start);
+    }
 }
 
 
@@ -758,6 +920,10 @@ DECLARE_PATCH(_Tactical_Render_Overlay_Patch)
         if (Vinifera_Developer_FrameStep) {
             TacticalMapExtension->Draw_FrameStep_Overlay();
         }
+
+        if (Vinifera_Developer_ShowStatistics) {
+            TacticalMapExtension->Draw_Statistics_Overlay();
+        }
     }
 
 #ifndef NDEBUG
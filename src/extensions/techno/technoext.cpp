@@ -27,6 +27,7 @@
  ******************************************************************************/
 #include "technoext.h"
 #include <algorithm>
+#include <cstring>
 #include "techno.h"
 #include "technotype.h"
 #include "technotypeext.h"
@@ -57,6 +58,30 @@
 #include "weapontype.h"
 
 
+int TechnoClassExtension::PassiveAcquireScanFrame = -1;
+int TechnoClassExtension::PassiveAcquireScanCount = 0;
+int TechnoClassExtension::PassiveAcquireScanLastCount = 0;
+
+
+/**
+ *  Recent attacks are recorded in coarse regions of the map, each region holds
+ *  the houses that attacked from it during the current scan interval. This lets
+ *  idle objects check for a new threat within range with a handful of lookups,
+ *  no matter how many attacks are made on a frame.
+ */
+#define THREAT_REGION_SIZE 8
+#define THREAT_REGION_W (MAP_CELL_W / THREAT_REGION_SIZE)
+#define THREAT_REGION_H (MAP_CELL_H / THREAT_REGION_SIZE)
+
+typedef struct ThreatRegionStruct
+{
+    int Frame;
+    unsigned long long Houses;
+} ThreatRegionStruct;
+
+static ThreatRegionStruct ThreatRegions[THREAT_REGION_H][THREAT_REGION_W];
+
+
 /**
  *  Class constructor.
  *  
@@ -71,7 +96,9 @@ TechnoClassExtension::TechnoClassExtension(const TechnoClass *this_ptr) :
     HasOpportunityFireTarget(false),
     LastTargetFrame(Frame),
     IsToResetBurst(false),
-    BurstResetTimer()
+    BurstResetTimer(),
+    NextPassiveAcquireFrame(0),
+    LastDamagedFrame(-1)
 {
     //if (this_ptr) EXT_DEBUG_TRACE("TechnoClassExtension::TechnoClassExtension - Name: %s (0x%08X)\n", Name(), (uintptr_t)(This()));
 
@@ -444,6 +471,170 @@ bool TechnoClassExtension::Can_Passive_Acquire() const
 }
 
 
+/**
+ *  Checks if this object is due to scan for a new target to passively acquire.
+ *
+ *  Scans are spread across the scan interval in buckets keyed by the object ID,
+ *  so large groups of idle units do not all scan on the same frame. This only
+ *  uses synchronised data, so it is safe for multiplayer games. If a scan is
+ *  due, the next scan is scheduled.
+ *
+ *  @author: CCHyper
+ */
+bool TechnoClassExtension::Is_Passive_Acquire_Scan_Due()
+{
+    //EXT_DEBUG_TRACE("TechnoClassExtension::Is_Passive_Acquire_Scan_Due - Name: %s (0x%08X)\n", Name(), (uintptr_t)(This()));
+
+    const int interval = RuleExtension->PassiveAcquireScanInterval;
+
+    if (interval > 1) {
+
+        /**
+         *  Objects that are under fire always look for a target to respond to.
+         */
+        const bool under_fire = LastDamagedFrame >= 0 && (Frame - LastDamagedFrame) <= interval;
+
+        if (!under_fire && Frame < NextPassiveAcquireFrame && !Is_Threat_In_Range(interval)) {
+            return false;
+        }
+
+        /**
+         *  Schedule the next scan into this object's bucket of the next interval.
+         */
+        NextPassiveAcquireFrame = (((Frame / interval) + 1) * interval) + (This()->ID % interval);
+    }
+
+    if (PassiveAcquireScanFrame != Frame) {
+        PassiveAcquireScanLastCount = PassiveAcquireScanCount;
+        PassiveAcquireScanCount = 0;
+        PassiveAcquireScanFrame = Frame;
+    }
+
+    ++PassiveAcquireScanCount;
+
+    return true;
+}
+
+
+/**
+ *  Checks if an enemy of this object has attacked from within its weapon
+ *  range during the last scan interval.
+ *
+ *  @author: CCHyper
+ */
+bool TechnoClassExtension::Is_Threat_In_Range(int interval) const
+{
+    const auto winfo = This()->Get_Weapon(WEAPON_SLOT_PRIMARY);
+    const int range = (winfo && winfo->Weapon) ? winfo->Weapon->Range : Techno_Type_Class()->ThreatRange;
+    const int range_cells = (range + CELL_LEPTON_W - 1) / CELL_LEPTON_W;
+
+    const Cell cell = This()->Get_Cell();
+    const int left = std::max(0, (cell.X - range_cells) / THREAT_REGION_SIZE);
+    const int top = std::max(0, (cell.Y - range_cells) / THREAT_REGION_SIZE);
+    const int right = std::min(THREAT_REGION_W - 1, (cell.X + range_cells) / THREAT_REGION_SIZE);
+    const int bottom = std::min(THREAT_REGION_H - 1, (cell.Y + range_cells) / THREAT_REGION_SIZE);
+
+    /**
+     *  The houses this object considers enemies, only worked out once a
+     *  region with a recent attack is found.
+     */
+    unsigned long long enemies = 0;
+    bool enemies_known = false;
+
+    for (int y = top; y <= bottom; ++y) {
+        for (int x = left; x <= right; ++x) {
+
+            const ThreatRegionStruct &region = ThreatRegions[y][x];
+
+            if (!region.Houses || region.Frame > Frame || (Frame - region.Frame) > interval) {
+                continue;
+            }
+
+            if (!enemies_known) {
+                for (int i = 0; i < Houses.Count() && i < 64; ++i) {
+                    if (!This()->House->Is_Ally(Houses[i])) {
+                        enemies |= (1ULL << i);
+                    }
+                }
+                enemies_known = true;
+            }
+
+            if (region.Houses & enemies) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ *  Records an attack made by the source object, so idle enemies that have
+ *  it within range may respond before their next scheduled scan.
+ *
+ *  @author: CCHyper
+ */
+void TechnoClassExtension::Record_Threat(const TechnoClass *source)
+{
+    if (!source || !source->House) {
+        return;
+    }
+
+    const Cell cell = source->Get_Cell();
+    if (cell.X < 0 || cell.X >= MAP_CELL_W || cell.Y < 0 || cell.Y >= MAP_CELL_H) {
+        return;
+    }
+
+    ThreatRegionStruct &region = ThreatRegions[cell.Y / THREAT_REGION_SIZE][cell.X / THREAT_REGION_SIZE];
+
+    /**
+     *  Forget the attacks of earlier intervals.
+     */
+    if (region.Frame > Frame || (Frame - region.Frame) > RuleExtension->PassiveAcquireScanInterval) {
+        region.Houses = 0;
+    }
+
+    /**
+     *  Houses outside of the mask are recorded as every house, so their
+     *  attacks still wake any enemy that is in range.
+     */
+    const int house = source->House->HeapID;
+    region.Houses |= (house >= 0 && house < 64) ? (1ULL << house) : ~0ULL;
+    region.Frame = Frame;
+}
+
+
+/**
+ *  Clears the recent threat records, this must be done when a scenario is
+ *  cleared so stale attacks are never seen by a new or loaded game.
+ *
+ *  @author: CCHyper
+ */
+void TechnoClassExtension::Clear_Threats()
+{
+    std::memset(ThreatRegions, 0, sizeof(ThreatRegions));
+}
+
+
+/**
+ *  Returns the number of passive acquire scans performed on the last game frame.
+ *
+ *  @author: CCHyper
+ */
+int TechnoClassExtension::Passive_Acquire_Scans_Last_Frame()
+{
+    if (PassiveAcquireScanFrame == Frame) {
+        return PassiveAcquireScanLastCount;
+    }
+
+    if (PassiveAcquireScanFrame == Frame-1) {
+        return PassiveAcquireScanCount;
+    }
+
+    return 0;
+}
+
 
 /**
  *  Determines the time it would take to build this object.
@@ -64,6 +64,7 @@ class TechnoClassExtension : public RadioClassExtension
         virtual void Response_Deploy();
         virtual void Response_Harvest();
         virtual bool Can_Passive_Acquire() const;
+        bool Is_Passive_Acquire_Scan_Due();
         virtual Coord Fire_Coord(WeaponSlotType which, TPoint3D<int> offset = TPoint3D<int>()) const;
 
         void Put_Storage_Pointers();
@@ -72,9 +73,14 @@ class TechnoClassExtension : public RadioClassExtension
         bool Can_Opportunity_Fire() const;
         bool Opportunity_Fire();
 
+        static int Passive_Acquire_Scans_Last_Frame();
+        static void Record_Threat(const TechnoClass *source);
+        static void Clear_Threats();
+
     private:
         const TechnoTypeClass *Techno_Type_Class() const;
         const TechnoTypeClassExtension *Techno_Type_Class_Ext() const;
+        bool Is_Threat_In_Range(int interval) const;
 
     public:
         /**
@@ -116,4 +122,22 @@ class TechnoClassExtension : public RadioClassExtension
          *  The countdown until burst gets reset if unit has lost the target.
          */
         CDTimerClass<FrameTimerClass> BurstResetTimer;
+
+        /**
+         *  The frame at which this object may next perform a passive acquire scan.
+         */
+        int NextPassiveAcquireFrame;
+
+        /**
+         *  When was this unit last damaged by an enemy?
+         */
+        int LastDamagedFrame;
+
+    private:
+        /**
+         *  Passive acquire scan counters for the developer overlay.
+         */
+        static int PassiveAcquireScanFrame;
+        static int PassiveAcquireScanCount;
+        static int PassiveAcquireScanLastCount;
 };
@@ -2241,6 +2241,16 @@ DECLARE_PATCH(_TechnoClass_Take_Damage_IsAffectsAllies_Patch)
 
     }
 
+    /**
+     *  Record when we were last hit by an enemy and where the attack came
+     *  from, this lets idle units respond to attacks and to new threats in
+     *  range without waiting for their next scheduled passive acquire scan.
+     */
+    if (source && *damage > 0 && !source->House->Is_Ally(this_ptr->House)) {
+        Extension::Fetch(this_ptr)->LastDamagedFrame = Frame;
+        TechnoClassExtension::Record_Threat(source);
+    }
+
     /**
      *  Stolen bytes/code.
      */
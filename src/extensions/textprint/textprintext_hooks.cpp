@@ -30,6 +30,7 @@
 #include "tibsun_defines.h"
 
 #include "wwfont.h"
+#include <cstring>
 
 
 #include "fatal.h"
@@ -40,6 +41,101 @@
 #include "hooker_macros.h"
 
 
+/**
+ *  The number of fonts that can have a cached character width table.
+ */
+#define FONT_WIDTH_TABLE_COUNT 8
+
+/**
+ *  The number of wrapped strings to remember, the longest string that will be
+ *  cached and the most line breaks a cached string can have.
+ */
+#define WINDOW_STRING_CACHE_SIZE 64
+#define WINDOW_STRING_CACHE_MAX_LENGTH 512
+#define WINDOW_STRING_CACHE_MAX_BREAKS 64
+
+
+/**
+ *  Pixel width of every character of a font, so measuring a string does not
+ *  need to query the font for each character. The character spacing is part
+ *  of the width, so the table is only valid for the spacing it was built with.
+ */
+typedef struct FontWidthTableStruct
+{
+    WWFontClass *Font;
+    int XSpacing;
+    int Widths[256];
+} FontWidthTableStruct;
+
+static FontWidthTableStruct FontWidthTables[FONT_WIDTH_TABLE_COUNT];
+static int FontWidthTableNext = 0;
+
+
+/**
+ *  The result of wrapping a string, stored as the offsets the formatter
+ *  replaced with a carriage return so it can be replayed onto the caller's buffer.
+ */
+typedef struct WindowStringCacheStruct
+{
+    bool IsValid;
+    unsigned Hash;
+    WWFontClass *Font;
+    int XSpacing;
+    int YSpacing;
+    int MaxLineLen;
+    char String[WINDOW_STRING_CACHE_MAX_LENGTH];
+    short Breaks[WINDOW_STRING_CACHE_MAX_BREAKS];
+    int BreakCount;
+    int Lines;
+    int Width;
+    int Height;
+} WindowStringCacheStruct;
+
+static WindowStringCacheStruct WindowStringCache[WINDOW_STRING_CACHE_SIZE];
+
+
+/**
+ *  Fetches the character width table for the font, building it on first use.
+ *
+ *  @author: CCHyper
+ */
+static const int *Font_Width_Table(WWFontClass *font)
+{
+    int xspacing = font->Get_X_Spacing();
+
+    for (int i = 0; i < FONT_WIDTH_TABLE_COUNT; ++i) {
+        if (FontWidthTables[i].Font == font && FontWidthTables[i].XSpacing == xspacing) {
+            return FontWidthTables[i].Widths;
+        }
+    }
+
+    /**
+     *  Not seen this font (or spacing) before, replace the oldest table.
+     */
+    FontWidthTableStruct &table = FontWidthTables[FontWidthTableNext];
+    FontWidthTableNext = (FontWidthTableNext + 1) % FONT_WIDTH_TABLE_COUNT;
+
+    table.Font = font;
+    table.XSpacing = xspacing;
+    for (int i = 0; i < 256; ++i) {
+        table.Widths[i] = font->Char_Pixel_Width(char(i));
+    }
+
+    return table.Widths;
+}
+
+
+/**
+ *  Fetches the pixel width of a character, from the table if one is given.
+ *
+ *  @author: CCHyper
+ */
+static inline int Char_Width(WWFontClass *font, const int *widths, char c)
+{
+    return widths ? widths[(unsigned char)c] : font->Char_Pixel_Width(c);
+}
+
+
 /**
  *  #issue-1085
  *
@@ -52,22 +148,18 @@
  *           05/18/1995 JLB : Greatly revised for new font system.
  *           09/04/1996 BWG : Added '@' is treated as a carriage return for width calculations.
  *           02/20/2024 Rampastring : Modified for Tiberian Sun and fixed the aforementioned bug.
+ *           CCHyper : Character widths are read from a per font table (or the
+ *                     font when no table is given), and the break positions
+ *                     are recorded for the layout cache.
  */
-int _Format_Window_String_Custom_Implementation(char* string, WWFontClass* font, int maxlinelen, int& width, int& height)
+static int Format_Window_String_Layout(char* string, WWFontClass* font, int maxlinelen, int& width, int& height, WindowStringCacheStruct *record, const int *widths)
 {
     int    linelen;
     int    lines = 0;
+    char * start = string;
     width = 0;
     height = 0;
 
-    // If no string was passed in, then there are no lines.
-    if (!string)
-        return 0;
-
-    // If no font was passed in, return no lines.
-    if (!font)
-        return 0;
-
     // While there are more letters left divide the line up.
     while (*string) {
         linelen = 0;
@@ -80,11 +172,18 @@ int _Format_Window_String_Custom_Implementation(char* string, WWFontClass* font,
         */
         if (*string == '@') {
             *string = '\r';
+
+            if (record && record->BreakCount < WINDOW_STRING_CACHE_MAX_BREAKS) {
+                record->Breaks[record->BreakCount] = short(string - start);
+            }
+            if (record) {
+                ++record->BreakCount;
+            }
         }
 
         // While the current line is less then the max length...
         while (linelen < maxlinelen && *string != '\r' && *string != '\0' && *string != '@') {
-            linelen += font->Char_Pixel_Width(*string);
+            linelen += Char_Width(font, widths, *string);
             string++;
         }
 
@@ -95,7 +194,7 @@ int _Format_Window_String_Custom_Implementation(char* string, WWFontClass* font,
             **    Back up to an appropriate location to break.
             */
             while (linelen > maxlinelen || (*string != ' ' && *string != '\r' && *string != '\0' && *string != '@')) {
-                linelen -= font->Char_Pixel_Width(*string);
+                linelen -= Char_Width(font, widths, *string);
                 string--;
             }
         }
@@ -115,6 +214,13 @@ int _Format_Window_String_Custom_Implementation(char* string, WWFontClass* font,
         **    Force a break at the end of the line.
         */
         if (*string) {
+            if (record && record->BreakCount < WINDOW_STRING_CACHE_MAX_BREAKS) {
+                record->Breaks[record->BreakCount] = short(string - start);
+            }
+            if (record) {
+                ++record->BreakCount;
+            }
+
             *string++ = '\r';
         }
     }
@@ -123,6 +229,102 @@ int _Format_Window_String_Custom_Implementation(char* string, WWFontClass* font,
 }
 
 
+/**
+ *  Formats a string to fit within the max line length, reusing the layout of a
+ *  previous call with the same string, font, spacing and width.
+ *
+ *  @author: CCHyper
+ */
+static int Format_Window_String_Cached(char* string, WWFontClass* font, int maxlinelen, int& width, int& height)
+{
+    int xspacing = font->Get_X_Spacing();
+    int yspacing = font->Get_Y_Spacing();
+
+    /**
+     *  Hash the string (FNV-1a) to find its cache slot.
+     */
+    unsigned hash = 2166136261U;
+    int length = 0;
+    for (const char *ptr = string; *ptr; ++ptr, ++length) {
+        hash = (hash ^ (unsigned char)*ptr) * 16777619U;
+    }
+    hash = (hash ^ unsigned(uintptr_t(font))) * 16777619U;
+    hash = (hash ^ unsigned(xspacing)) * 16777619U;
+    hash = (hash ^ unsigned(yspacing)) * 16777619U;
+    hash = (hash ^ unsigned(maxlinelen)) * 16777619U;
+
+    /**
+     *  Long strings are formatted directly, they are rare and would not fit the cache.
+     */
+    if (length >= WINDOW_STRING_CACHE_MAX_LENGTH) {
+        return Format_Window_String_Layout(string, font, maxlinelen, width, height, nullptr, Font_Width_Table(font));
+    }
+
+    WindowStringCacheStruct &entry = WindowStringCache[hash % WINDOW_STRING_CACHE_SIZE];
+
+    if (entry.IsValid && entry.Hash == hash && entry.Font == font
+     && entry.XSpacing == xspacing && entry.YSpacing == yspacing && entry.MaxLineLen == maxlinelen
+     && std::strcmp(entry.String, string) == 0) {
+
+        /**
+         *  Replay the recorded line breaks onto the caller's buffer.
+         */
+        for (int i = 0; i < entry.BreakCount; ++i) {
+            string[entry.Breaks[i]] = '\r';
+        }
+
+        width = entry.Width;
+        height = entry.Height;
+        return entry.Lines;
+    }
+
+    entry.IsValid = false;
+    entry.BreakCount = 0;
+    std::memcpy(entry.String, string, length+1);
+
+    int lines = Format_Window_String_Layout(string, font, maxlinelen, width, height, &entry, Font_Width_Table(font));
+
+    /**
+     *  Only keep the result if every break position fitted in the record.
+     */
+    if (entry.BreakCount <= WINDOW_STRING_CACHE_MAX_BREAKS) {
+        entry.IsValid = true;
+        entry.Hash = hash;
+        entry.Font = font;
+        entry.XSpacing = xspacing;
+        entry.YSpacing = yspacing;
+        entry.MaxLineLen = maxlinelen;
+        entry.Lines = lines;
+        entry.Width = width;
+        entry.Height = height;
+    }
+
+    return lines;
+}
+
+
+/**
+ *  Formats a string to fit within the max line length, see Format_Window_String_Cached.
+ *
+ *  @author: CCHyper
+ */
+int _Format_Window_String_Custom_Implementation(char* string, WWFontClass* font, int maxlinelen, int& width, int& height)
+{
+    width = 0;
+    height = 0;
+
+    // If no string was passed in, then there are no lines.
+    if (!string)
+        return 0;
+
+    // If no font was passed in, return no lines.
+    if (!font)
+        return 0;
+
+    return Format_Window_String_Cached(string, font, maxlinelen, width, height);
+}
+
+
 void TextPrintExtension_Hooks()
 {
     Patch_Jump(0x00474960, &_Format_Window_String_Custom_Implementation);
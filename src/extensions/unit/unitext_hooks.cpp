@@ -48,6 +48,8 @@
 #include "rulesext.h"
 #include "iomap.h"
 #include "infantry.h"
+#include "house.h"
+#include "buildingtype.h"
 #include "voc.h"
 #include "extension.h"
 #include "unitext.h"
@@ -1312,6 +1314,32 @@ void UnitClassExtension_Find_Nearest_Refinery(UnitClass* this_ptr, BuildingClass
     for (int i = 0; i < this_ptr->Class->Dock.Count(); i++) {
         BuildingTypeClass* dockbuildingtype = this_ptr->Class->Dock[i];
 
+        /**
+         *  Find_Docking_Bay scans every building on the map, so skip the call for
+         *  dock types the house has none of. The house building tracker is kept
+         *  up to date as buildings are placed, captured, sold or destroyed, so this
+         *  never skips a type that could have produced a result.
+         *
+         *  @note: This only filters the dock types, each remaining type is still
+         *         a full scan of the building heap.
+         *
+         *  #TODO:
+         *  A per house dock index (kept up to date on placement, capture, sale
+         *  and destruction) would make this sub-linear, but it needs a
+         *  reimplementation of Find_Docking_Bay with its radio and reservation
+         *  checks so the tie-breaks stay identical. It is not implemented yet.
+         */
+        if (!this_ptr->House->ActiveBQuantity.Count_Of(dockbuildingtype->HeapID)) {
+            continue;
+        }
+
+        /**
+         *  The same type may be listed more than once, it would only yield the same building again.
+         */
+        if (this_ptr->Class->Dock.ID(dockbuildingtype) != i) {
+            continue;
+        }
+
         BuildingClass* dockbuilding = this_ptr->Find_Docking_Bay(dockbuildingtype, false, false);
         if (dockbuilding == nullptr)
             continue;
@@ -122,9 +122,10 @@ BOOL WINAPI DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved
             }
 
             /**
-             *  Collect the debug files from this session.
+             *  Collect the debug files from this session. The loader lock is held
+             *  here, so a worker thread would not start until we return.
              */
-            Vinifera_Collect_Debug_Files();
+            Vinifera_Collect_Debug_Files(false);
             
             DLLInstance = nullptr;
 
@@ -38,7 +38,6 @@
 #include "rgb.h"
 #include "dsurface.h"
 #include "rules.h"
-#include "random.h"
 #include "wwmath.h"
 #include "clipline.h"
 #include "extension.h"
@@ -46,6 +45,44 @@
 #include "asserthandler.h"
 
 
+/**
+ *  Electric bolts are purely visual, and the number of times they are plotted
+ *  depends on the render rate of each machine, so they must not draw from the
+ *  synchronised random number generator. This is a visual only generator.
+ */
+static unsigned EBoltRandomSeed = 0x0B01D5EE;
+
+static int EBolt_Random_Pick(int a, int b)
+{
+    if (a > b) {
+        std::swap(a, b);
+    }
+
+    EBoltRandomSeed = (EBoltRandomSeed * 214013) + 2531011;
+
+    return a + int(((EBoltRandomSeed >> 16) & 0x7FFF) % unsigned((b - a) + 1));
+}
+
+
+/**
+ *  Precomputed line deviation table, replacing the per plot WWMath::Sin calls.
+ *  Indexed by the deviation value index and the random pick [0..256].
+ */
+static double EBoltDeviationTable[6][257];
+static bool EBoltDeviationTableInit = false;
+
+static void EBolt_Init_Deviation_Table()
+{
+    for (int i = 0; i < std::size(EBoltDeviationTable); ++i) {
+        for (int j = 0; j < std::size(EBoltDeviationTable[i]); ++j) {
+            EBoltDeviationTable[i][j] = WWMath::Sin((double)j * WWMATH_PI / (double)(i + 7));
+        }
+    }
+
+    EBoltDeviationTableInit = true;
+}
+
+
 /**
  *  Class constructor
  * 
@@ -66,7 +103,9 @@ EBoltClass::EBoltClass() :
     LineColor3(EBOLT_DEFAULT_COLOR_3),
     LineSegmentCount(EBOLT_DEFAULT_LINE_SEGEMENTS),
     LineDrawList(),
-    DrawFrame(-1)
+    DrawFrame(-1),
+    ProjectedViewPosition(),
+    IsProjected(false)
 {
 }
 
@@ -96,6 +135,7 @@ void EBoltClass::Clear()
     }
 
     LineDrawList.Clear();
+    IsProjected = false;
 }
 
 
@@ -121,6 +161,7 @@ void EBoltClass::Draw_It()
          *  Clear previous lines, we are about to plot a new set.
          */
         LineDrawList.Clear();
+        IsProjected = false;
 
         for (int i = 0; i < IterationCount; ++i) {
             if (Lifetime) {
@@ -314,6 +355,10 @@ void EBoltClass::Plot_Bolt(Coord &start, Coord &end)
     bool init_deviation_values = true;
     int plot_index = 0;
 
+    if (!EBoltDeviationTableInit) {
+        EBolt_Init_Deviation_Table();
+    }
+
     /**
      *  Check to make sure there is actual distance between the two coords.
      */
@@ -352,7 +397,7 @@ void EBoltClass::Plot_Bolt(Coord &start, Coord &end)
                 if (init_deviation_values) {
 
                     for (int i = 0; i < std::size(deviation_values); ++i) {
-                        deviation_values[i] = (WWMath::Sin((double)Sim_Random_Pick(0, 256) * WWMATH_PI / (double)(i + 7)) * (double)line_deviation);
+                        deviation_values[i] = (EBoltDeviationTable[i][EBolt_Random_Pick(0, 256)] * (double)line_deviation);
                     }
 
                     for (int i = 0; i < EBOLT_DEFAULT_SEGMENT_LINES; ++i) {
@@ -365,28 +410,28 @@ void EBoltClass::Plot_Bolt(Coord &start, Coord &end)
                 }
 
                 if (distance <= (CELL_LEPTON_W/2)) {
-                    working_coords[0].X += 2 * line_deviation * Sim_Random_Pick(-1, 1);
-                    working_coords[0].Y += 2 * line_deviation * Sim_Random_Pick(-1, 1);
-                    working_coords[0].Z += 2 * line_deviation * Sim_Random_Pick(-1, 1);
+                    working_coords[0].X += 2 * line_deviation * EBolt_Random_Pick(-1, 1);
+                    working_coords[0].Y += 2 * line_deviation * EBolt_Random_Pick(-1, 1);
+                    working_coords[0].Z += 2 * line_deviation * EBolt_Random_Pick(-1, 1);
                 } else {
-                    working_coords[0].X += Sim_Random_Pick(-line_deviation, line_deviation);
-                    working_coords[0].Y += Sim_Random_Pick(-line_deviation, line_deviation);
-                    working_coords[0].Z += Sim_Random_Pick(-line_deviation, line_deviation);
+                    working_coords[0].X += EBolt_Random_Pick(-line_deviation, line_deviation);
+                    working_coords[0].Y += EBolt_Random_Pick(-line_deviation, line_deviation);
+                    working_coords[0].Z += EBolt_Random_Pick(-line_deviation, line_deviation);
                 }
 
                 if (distance > dist_a) {
                     for (int i = 1; i < EBOLT_DEFAULT_SEGMENT_LINES; ++i) {
-                        working_coords[i].X = working_coords[0].X + (Sim_Random_Pick(-line_deviation, line_deviation) / 2);
-                        working_coords[i].Y = working_coords[0].Y + (Sim_Random_Pick(-line_deviation, line_deviation) / 2);
-                        working_coords[i].Z = working_coords[0].Z + (Sim_Random_Pick(-line_deviation, line_deviation) / 2);
+                        working_coords[i].X = working_coords[0].X + (EBolt_Random_Pick(-line_deviation, line_deviation) / 2);
+                        working_coords[i].Y = working_coords[0].Y + (EBolt_Random_Pick(-line_deviation, line_deviation) / 2);
+                        working_coords[i].Z = working_coords[0].Z + (EBolt_Random_Pick(-line_deviation, line_deviation) / 2);
 
                     }
 
                 } else {
                     for (int i = 1; i < EBOLT_DEFAULT_SEGMENT_LINES; ++i) {
-                        working_coords[i].X += Sim_Random_Pick(-line_deviation, line_deviation);
-                        working_coords[i].Y += Sim_Random_Pick(-line_deviation, line_deviation);
-                        working_coords[i].Z += Sim_Random_Pick(-line_deviation, line_deviation);
+                        working_coords[i].X += EBolt_Random_Pick(-line_deviation, line_deviation);
+                        working_coords[i].Y += EBolt_Random_Pick(-line_deviation, line_deviation);
+                        working_coords[i].Z += EBolt_Random_Pick(-line_deviation, line_deviation);
                     }
                 }
 
@@ -435,6 +480,30 @@ void EBoltClass::Plot_Bolt(Coord &start, Coord &end)
 }
 
 
+/**
+ *  Projects all pending lines into screen space and caches the result.
+ * 
+ *  @author: CCHyper
+ */
+void EBoltClass::Project_Lines()
+{
+    for (int i = 0; i < LineDrawList.Count(); ++i) {
+        LineDrawDataStruct &data = LineDrawList[i];
+
+        TacticalMap->Coord_To_Pixel(data.Start, data.StartPixel);
+        TacticalMap->Coord_To_Pixel(data.End, data.EndPixel);
+
+        data.StartPixelZ = data.StartZ - TacticalMap->Z_Lepton_To_Pixel(data.Start.Z) - 2;
+        data.EndPixelZ = data.EndZ - TacticalMap->Z_Lepton_To_Pixel(data.End.Z) - 2;
+
+        data.Pixel = DSurface::RGB_To_Pixel(data.Color.Red, data.Color.Green, data.Color.Blue);
+    }
+
+    ProjectedViewPosition = TacticalMap->field_5C;
+    IsProjected = true;
+}
+
+
 /**
  *  Draw all pending bolts to the game surface.
  * 
@@ -442,20 +511,39 @@ void EBoltClass::Plot_Bolt(Coord &start, Coord &end)
  */
 void EBoltClass::Draw_Bolts()
 {
-    for (int i = 0; i < LineDrawList.Count(); ++i) {
-        LineDrawDataStruct &data = LineDrawList[i];
+    /**
+     *  Only project the lines again if they have been re-plotted
+     *  or the tactical view has moved since they were last projected.
+     */
+    if (!IsProjected
+        || ProjectedViewPosition.X != TacticalMap->field_5C.X
+        || ProjectedViewPosition.Y != TacticalMap->field_5C.Y) {
+
+        Project_Lines();
+    }
 
-        Point2D start_pixel;
-        Point2D end_pixel;
+    const int left = TacticalRect.X;
+    const int top = TacticalRect.Y;
+    const int right = TacticalRect.X + TacticalRect.Width;
+    const int bottom = TacticalRect.Y + TacticalRect.Height;
 
-        TacticalMap->Coord_To_Pixel(data.Start, start_pixel);
-        TacticalMap->Coord_To_Pixel(data.End, end_pixel);
+    for (int i = 0; i < LineDrawList.Count(); ++i) {
+        const LineDrawDataStruct &data = LineDrawList[i];
+
+        /**
+         *  Skip lines that are entirely off one side of the tactical view.
+         */
+        if ((data.StartPixel.X < left && data.EndPixel.X < left)
+            || (data.StartPixel.X >= right && data.EndPixel.X >= right)
+            || (data.StartPixel.Y < top && data.EndPixel.Y < top)
+            || (data.StartPixel.Y >= bottom && data.EndPixel.Y >= bottom)) {
 
-        int start_z = data.StartZ - TacticalMap->Z_Lepton_To_Pixel(data.Start.Z) - 2;
-        int end_z = data.EndZ - TacticalMap->Z_Lepton_To_Pixel(data.End.Z) - 2;
+            continue;
+        }
 
-        unsigned color = DSurface::RGB_To_Pixel(data.Color.Red, data.Color.Green, data.Color.Blue);
+        Point2D start_pixel = data.StartPixel;
+        Point2D end_pixel = data.EndPixel;
 
-        CompositeSurface->Draw_Line_entry_34(TacticalRect, start_pixel, end_pixel, color, start_z, end_z);
+        CompositeSurface->Draw_Line_entry_34(TacticalRect, start_pixel, end_pixel, data.Pixel, data.StartPixelZ, data.EndPixelZ);
     }
 }
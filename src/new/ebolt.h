@@ -31,6 +31,7 @@
 #include "rgb.h"
 #include "vector.h"
 #include "tibsun_defines.h"
+#include "point.h"
 
 
 class TechnoClass;
@@ -74,9 +75,11 @@ class EBoltClass
         void Add_Plot_Line(Coord &start, Coord &end, RGBClass &line_color, int start_z, int end_z)
         {
             LineDrawList.Add( LineDrawDataStruct { start, end, line_color, start_z, end_z } );
+            IsProjected = false;
         }
 
         void Plot_Bolt(Coord &start, Coord &end);
+        void Project_Lines();
         void Draw_Bolts();
 
     private:
@@ -150,6 +153,15 @@ class EBoltClass
             int StartZ;
             int EndZ;
 
+            /**
+             *  Screen space data, cached by Project_Lines().
+             */
+            Point2D StartPixel;
+            Point2D EndPixel;
+            int StartPixelZ;
+            int EndPixelZ;
+            unsigned Pixel;
+
             bool operator==(const LineDrawDataStruct &that) const { return std::memcmp(this, &that, sizeof(LineDrawDataStruct)) == 0; }
             bool operator!=(const LineDrawDataStruct &that) const { return std::memcmp(this, &that, sizeof(LineDrawDataStruct)) != 0; }
         };
@@ -160,4 +172,11 @@ class EBoltClass
          *  to the games internal frame tick.
          */
         int DrawFrame;
+
+        /**
+         *  The tactical view position the cached screen space line data was
+         *  projected for. The lines only need projecting again if this changes.
+         */
+        Point2D ProjectedViewPosition;
+        bool IsProjected;
 };
@@ -0,0 +1,324 @@
+/*******************************************************************************
+/*                 O P E N  S O U R C E  --  V I N I F E R A                  **
+/*******************************************************************************
+ *
+ *  @project       Vinifera
+ *
+ *  @file          EVENTTELEMETRY.CPP
+ *
+ *  @author        CCHyper
+ *
+ *  @brief         Latency and throughput telemetry for the network event queue.
+ *
+ *  @license       Vinifera is free software: you can redistribute it and/or
+ *                 modify it under the terms of the GNU General Public License
+ *                 as published by the Free Software Foundation, either version
+ *                 3 of the License, or (at your option) any later version.
+ *
+ *                 Vinifera is distributed in the hope that it will be
+ *                 useful, but WITHOUT ANY WARRANTY; without even the implied
+ *                 warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *                 PURPOSE. See the GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public
+ *                 License along with this program.
+ *                 If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#include "eventtelemetry.h"
+#include "tibsun_globals.h"
+#include "vinifera_globals.h"
+#include "event.h"
+#include "house.h"
+#include "miscutil.h"
+#include "debughandler.h"
+#include "asserthandler.h"
+#include <Windows.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+bool EventTelemetry::Enabled = false;
+EventTypeTelemetry EventTelemetry::TypeEntries[EVENT_TELEMETRY_MAX_TYPES];
+HouseEventTelemetry EventTelemetry::HouseEntries[EVENT_TELEMETRY_MAX_HOUSES];
+QueuedEventTelemetry EventTelemetry::QueuedEntries[EVENT_TELEMETRY_MAX_QUEUED];
+int EventTelemetry::QueuedCount = 0;
+unsigned EventTelemetry::WindowStart = 0;
+double EventTelemetry::TicksPerMicrosecond = 0.0;
+
+
+/**
+ *  Clears the counters and starts recording.
+ *
+ *  @author: CCHyper
+ */
+void EventTelemetry::Start()
+{
+    if (TicksPerMicrosecond == 0.0) {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        TicksPerMicrosecond = double(frequency.QuadPart) / 1000000.0;
+    }
+
+    Reset();
+    Enabled = true;
+
+    DEBUG_INFO("Event telemetry started.\n");
+}
+
+
+/**
+ *  Stops recording, the counters are kept so they can still be written out.
+ *
+ *  @author: CCHyper
+ */
+void EventTelemetry::Stop()
+{
+    Enabled = false;
+
+    DEBUG_INFO("Event telemetry stopped.\n");
+}
+
+
+/**
+ *  Clears all the counters.
+ *
+ *  @author: CCHyper
+ */
+void EventTelemetry::Reset()
+{
+    std::memset(TypeEntries, 0, sizeof(TypeEntries));
+    std::memset(HouseEntries, 0, sizeof(HouseEntries));
+    QueuedCount = 0;
+    WindowStart = timeGetTime();
+}
+
+
+/**
+ *  Finds the queued entry matching an event, ignoring the frame it is stamped with.
+ */
+static int Find_Queued(const QueuedEventTelemetry *entries, int count, const EventClass &event)
+{
+    for (int i = 0; i < count; ++i) {
+        if (entries[i].Type == event.Type
+         && entries[i].ID == event.ID
+         && std::memcmp(entries[i].Data, &event.Data, sizeof(entries[i].Data)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+/**
+ *  Records the frame and time of any new events in the outgoing queue.
+ * 
+ *  @note: The game adds to the outgoing queue from many places, so it is
+ *         sampled instead. Events that are added and sent between two samples
+ *         are never seen, and are counted as unmatched when executed.
+ *
+ *  @author: CCHyper
+ */
+void EventTelemetry::Record_Queued()
+{
+    if (!Enabled) {
+        return;
+    }
+
+    unsigned now = timeGetTime();
+
+    for (int i = 0; i < OutList.Count; ++i) {
+        const EventClass &event = OutList[i];
+
+        if (Find_Queued(QueuedEntries, QueuedCount, event) != -1) {
+            continue;
+        }
+
+        /**
+         *  Forget the oldest entry if the list is full, it was most likely
+         *  never sent.
+         */
+        if (QueuedCount == EVENT_TELEMETRY_MAX_QUEUED) {
+            std::memmove(&QueuedEntries[0], &QueuedEntries[1], sizeof(QueuedEntries[0]) * (QueuedCount-1));
+            --QueuedCount;
+        }
+
+        QueuedEventTelemetry &entry = QueuedEntries[QueuedCount++];
+        entry.Type = event.Type;
+        entry.ID = event.ID;
+        std::memcpy(entry.Data, &event.Data, sizeof(entry.Data));
+        entry.Frame = Frame;
+        entry.Time = now;
+    }
+}
+
+
+/**
+ *  Closes the rate window once a second has passed. Called once per main loop.
+ *
+ *  @author: CCHyper
+ */
+void EventTelemetry::Update()
+{
+    if (!Enabled) {
+        return;
+    }
+
+    Record_Queued();
+
+    unsigned now = timeGetTime();
+    if ((now - WindowStart) < 1000) {
+        return;
+    }
+
+    for (int i = 0; i < EVENT_TELEMETRY_MAX_HOUSES; ++i) {
+        HouseEntries[i].Rate = HouseEntries[i].WindowCount;
+        HouseEntries[i].WindowCount = 0;
+    }
+
+    WindowStart = now;
+}
+
+
+/**
+ *  Records an event as it is taken from the queue for execution.
+ *
+ *  @author: CCHyper
+ */
+void EventTelemetry::Record_Event(const EventClass &event)
+{
+    int type = event.Type;
+    if (type >= 0 && type < EVENT_TELEMETRY_MAX_TYPES) {
+
+        EventTypeTelemetry &entry = TypeEntries[type];
+
+        ++entry.Count;
+
+        /**
+         *  Events only execute on the frame they are stamped with, so the
+         *  latency is measured from when the event was seen in the outgoing
+         *  queue. This includes the time spent waiting on other players.
+         */
+        int index = Find_Queued(QueuedEntries, QueuedCount, event);
+        if (index != -1) {
+            int delay = std::max(0, int(Frame - QueuedEntries[index].Frame));
+            unsigned delay_ms = timeGetTime() - QueuedEntries[index].Time;
+
+            ++entry.LatencyCount;
+            entry.TotalDelay += delay;
+            entry.MaxDelay = std::max(entry.MaxDelay, delay);
+            entry.TotalDelayMs += delay_ms;
+            entry.MaxDelayMs = std::max(entry.MaxDelayMs, delay_ms);
+
+            std::memmove(&QueuedEntries[index], &QueuedEntries[index+1], sizeof(QueuedEntries[0]) * (QueuedCount-index-1));
+            --QueuedCount;
+        }
+    }
+
+    int house = event.ID;
+    if (house >= 0 && house < EVENT_TELEMETRY_MAX_HOUSES) {
+
+        HouseEventTelemetry &entry = HouseEntries[house];
+
+        ++entry.Count;
+        ++entry.WindowCount;
+        entry.Bytes += EventClass::Event_Length(event.Type);
+    }
+}
+
+
+/**
+ *  Returns the current value of the performance counter.
+ *
+ *  @author: CCHyper
+ */
+long long EventTelemetry::Timestamp()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+
+/**
+ *  Records the time taken to execute an event, "start" is the timestamp taken
+ *  before the event was executed.
+ *
+ *  @author: CCHyper
+ */
+void EventTelemetry::Record_Execution(int type, long long start)
+{
+    if (type < 0 || type >= EVENT_TELEMETRY_MAX_TYPES) {
+        return;
+    }
+
+    double time = double(Timestamp() - start) / TicksPerMicrosecond;
+
+    EventTypeTelemetry &entry = TypeEntries[type];
+
+    ++entry.TimedCount;
+    entry.TotalTime += time;
+    entry.MaxTime = std::max(entry.MaxTime, time);
+}
+
+
+/**
+ *  Writes the counters to a CSV file in the debug directory.
+ *
+ *  @author: CCHyper
+ */
+bool EventTelemetry::Write_CSV()
+{
+    int day = 0;
+    int month = 0;
+    int year = 0;
+    int hour = 0;
+    int min = 0;
+    int sec = 0;
+
+    Get_Full_Time(day, month, year, hour, min, sec);
+
+    char filename_buffer[512];
+    std::snprintf(filename_buffer, sizeof(filename_buffer), "%s\\EVENTS_%02u-%02u-%04u_%02u-%02u-%02u.CSV",
+        Vinifera_DebugDirectory,
+        day, month, year, hour, min, sec);
+
+    FILE *fp = std::fopen(filename_buffer, "w+");
+    if (fp == nullptr) {
+        DEBUG_ERROR("Failed to open event telemetry file for writing!\n");
+        return false;
+    }
+
+    std::fprintf(fp, "Event,Count,Matched,AvgDelay,MaxDelay,AvgDelayMs,MaxDelayMs,Timed,AvgTimeUs,MaxTimeUs\n");
+
+    for (int i = 0; i < EVENT_TELEMETRY_MAX_TYPES; ++i) {
+        const EventTypeTelemetry &entry = TypeEntries[i];
+        if (!entry.Count) {
+            continue;
+        }
+        std::fprintf(fp, "%s,%d,%d,%.2f,%d,%.2f,%u,%d,%.2f,%.2f\n",
+            EventClass::Event_Name(EventType(i)), entry.Count, entry.LatencyCount,
+            entry.LatencyCount ? (double(entry.TotalDelay) / entry.LatencyCount) : 0.0, entry.MaxDelay,
+            entry.LatencyCount ? (double(entry.TotalDelayMs) / entry.LatencyCount) : 0.0, entry.MaxDelayMs,
+            entry.TimedCount,
+            entry.TimedCount ? (entry.TotalTime / entry.TimedCount) : 0.0, entry.MaxTime);
+    }
+
+    std::fprintf(fp, "\nHouse,Name,Count,Bytes,EventsPerSecond\n");
+
+    for (int i = 0; i < EVENT_TELEMETRY_MAX_HOUSES; ++i) {
+        const HouseEventTelemetry &entry = HouseEntries[i];
+        if (!entry.Count) {
+            continue;
+        }
+        const char *name = (i < ::Houses.Count()) ? ::Houses[i]->IniName : "<unknown>";
+        std::fprintf(fp, "%d,%s,%d,%d,%d\n", i, name, entry.Count, entry.Bytes, entry.Rate);
+    }
+
+    std::fclose(fp);
+
+    DEBUG_INFO("Event telemetry written to %s.\n", filename_buffer);
+
+    return true;
+}
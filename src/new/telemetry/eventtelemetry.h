@@ -0,0 +1,152 @@
+/*******************************************************************************
+/*                 O P E N  S O U R C E  --  V I N I F E R A                  **
+/*******************************************************************************
+ *
+ *  @project       Vinifera
+ *
+ *  @file          EVENTTELEMETRY.H
+ *
+ *  @author        CCHyper
+ *
+ *  @brief         Latency and throughput telemetry for the network event queue.
+ *
+ *  @license       Vinifera is free software: you can redistribute it and/or
+ *                 modify it under the terms of the GNU General Public License
+ *                 as published by the Free Software Foundation, either version
+ *                 3 of the License, or (at your option) any later version.
+ *
+ *                 Vinifera is distributed in the hope that it will be
+ *                 useful, but WITHOUT ANY WARRANTY; without even the implied
+ *                 warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *                 PURPOSE. See the GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public
+ *                 License along with this program.
+ *                 If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include "always.h"
+#include "event.h"
+
+
+#define EVENT_TELEMETRY_MAX_TYPES 64
+#define EVENT_TELEMETRY_MAX_HOUSES 32
+#define EVENT_TELEMETRY_MAX_QUEUED 128
+
+
+/**
+ *  Counters for a single event type.
+ */
+struct EventTypeTelemetry
+{
+    /**
+     *  Number of events of this type executed.
+     */
+    int Count;
+
+    /**
+     *  Frames and milliseconds between the event being seen in the outgoing
+     *  queue and it being executed. Only local events that were seen in the
+     *  queue are measured, the rest are counted as unmatched.
+     */
+    int LatencyCount;
+    int TotalDelay;
+    int MaxDelay;
+    unsigned TotalDelayMs;
+    unsigned MaxDelayMs;
+
+    /**
+     *  Execution time in microseconds. Only the events handled by Vinifera
+     *  are timed, the rest are executed by the game.
+     */
+    int TimedCount;
+    double TotalTime;
+    double MaxTime;
+};
+
+
+/**
+ *  An event seen in the outgoing queue, waiting to be executed.
+ */
+struct QueuedEventTelemetry
+{
+    EventType Type;
+    int ID;
+    char Data[sizeof(EventClass::Data)];
+
+    /**
+     *  The frame and time the event was first seen in the outgoing queue.
+     */
+    unsigned Frame;
+    unsigned Time;
+};
+
+
+/**
+ *  Counters for the events issued by a single house.
+ */
+struct HouseEventTelemetry
+{
+    int Count;
+    int Bytes;
+
+    /**
+     *  Events counted in the current one second window, and the total of
+     *  the last complete window.
+     */
+    int WindowCount;
+    int Rate;
+};
+
+
+class EventTelemetry
+{
+public:
+    EventTelemetry() = delete;
+
+    static void Start();
+    static void Stop();
+    static void Reset();
+    static void Update();
+
+    static bool Is_Enabled() { return Enabled; }
+
+    static void Record_Queued();
+    static void Record_Event(const EventClass &event);
+    static long long Timestamp();
+    static void Record_Execution(int type, long long start);
+
+    static bool Write_CSV();
+
+    static const EventTypeTelemetry &Type_Entry(int type) { return TypeEntries[type]; }
+    static const HouseEventTelemetry &House_Entry(int house) { return HouseEntries[house]; }
+
+private:
+    /**
+     *  Is the telemetry being recorded? The hooks check this before doing
+     *  anything else, so there is no cost when it is disabled.
+     */
+    static bool Enabled;
+
+    static EventTypeTelemetry TypeEntries[EVENT_TELEMETRY_MAX_TYPES];
+    static HouseEventTelemetry HouseEntries[EVENT_TELEMETRY_MAX_HOUSES];
+
+    /**
+     *  Events seen in the outgoing queue that have not been executed yet,
+     *  oldest first.
+     */
+    static QueuedEventTelemetry QueuedEntries[EVENT_TELEMETRY_MAX_QUEUED];
+    static int QueuedCount;
+
+    /**
+     *  When the current rate window started, in milliseconds.
+     */
+    static unsigned WindowStart;
+
+    /**
+     *  Ticks per microsecond of the performance counter.
+     */
+    static double TicksPerMicrosecond;
+};
@@ -0,0 +1,315 @@
+/*******************************************************************************
+/*                 O P E N  S O U R C E  --  V I N I F E R A                  **
+/*******************************************************************************
+ *
+ *  @project       Vinifera
+ *
+ *  @file          MEMORYTELEMETRY.CPP
+ *
+ *  @author        CCHyper
+ *
+ *  @brief         Live memory and object count telemetry for developer mode.
+ *
+ *  @license       Vinifera is free software: you can redistribute it and/or
+ *                 modify it under the terms of the GNU General Public License
+ *                 as published by the Free Software Foundation, either version
+ *                 3 of the License, or (at your option) any later version.
+ *
+ *                 Vinifera is distributed in the hope that it will be
+ *                 useful, but WITHOUT ANY WARRANTY; without even the implied
+ *                 warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *                 PURPOSE. See the GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public
+ *                 License along with this program.
+ *                 If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#include "memorytelemetry.h"
+#include "tibsun_globals.h"
+#include "vinifera_globals.h"
+#include "vinifera_newdel.h"
+#include "extension_globals.h"
+#include "unit.h"
+#include "infantry.h"
+#include "building.h"
+#include "aircraft.h"
+#include "anim.h"
+#include "particle.h"
+#include "particlesys.h"
+#include "wave.h"
+#include "bullet.h"
+#include "voxelanim.h"
+#include "terrain.h"
+#include "overlay.h"
+#include "smudge.h"
+#include "factory.h"
+#include "super.h"
+#include "team.h"
+#include "trigger.h"
+#include "tag.h"
+#include "ebolt.h"
+#include "unitext.h"
+#include "infantryext.h"
+#include "buildingext.h"
+#include "aircraftext.h"
+#include "animext.h"
+#include "waveext.h"
+#include "terrainext.h"
+#include "overlayext.h"
+#include "smudgeext.h"
+#include "factoryext.h"
+#include "superext.h"
+#include "miscutil.h"
+#include "debughandler.h"
+#include "asserthandler.h"
+#include <algorithm>
+#include <cstring>
+
+
+/**
+ *  Helper for sampling a heap of pointers to objects of a known type.
+ */
+#define TELEMETRY_RECORD(name, heap, type) Record(name, heap.Count(), sizeof(type))
+
+
+int MemoryTelemetry::LogInterval = 30;
+
+TelemetryEntry MemoryTelemetry::Entries[TELEMETRY_MAX_ENTRIES];
+int MemoryTelemetry::EntryCount = 0;
+int MemoryTelemetry::RecordIndex = 0;
+int MemoryTelemetry::LastFrame = -1;
+unsigned MemoryTelemetry::LastAllocationCount = 0;
+int MemoryTelemetry::LastDeleteCount = 0;
+int MemoryTelemetry::AllocationsLastFrame = 0;
+int MemoryTelemetry::FreesLastFrame = 0;
+FILE *MemoryTelemetry::LogFile = nullptr;
+
+
+/**
+ *  Samples all the tracked heaps. Should be called once per game frame.
+ *
+ *  @author: CCHyper
+ */
+void MemoryTelemetry::Update()
+{
+    /**
+     *  The main loop is still called while the game is paused, only take
+     *  one sample for each logic frame.
+     */
+    if (Frame == LastFrame) {
+        return;
+    }
+
+    /**
+     *  The frame counter went backwards, so a new scenario was started
+     *  or a saved game was loaded. Start over from a fresh baseline.
+     */
+    if (Frame < LastFrame) {
+        Reset();
+    }
+
+    LastFrame = Frame;
+
+    AllocationsLastFrame = int(Vinifera_Allocation_Count - LastAllocationCount);
+    FreesLastFrame = Vinifera_Delete_Count - LastDeleteCount;
+    LastAllocationCount = Vinifera_Allocation_Count;
+    LastDeleteCount = Vinifera_Delete_Count;
+
+    RecordIndex = 0;
+
+    /**
+     *  Game object heaps.
+     */
+    TELEMETRY_RECORD("Units", Units, UnitClass);
+    TELEMETRY_RECORD("Infantry", Infantry, InfantryClass);
+    TELEMETRY_RECORD("Buildings", Buildings, BuildingClass);
+    TELEMETRY_RECORD("Aircraft", Aircrafts, AircraftClass);
+    TELEMETRY_RECORD("Anims", Anims, AnimClass);
+    TELEMETRY_RECORD("Particles", Particles, ParticleClass);
+    TELEMETRY_RECORD("ParticleSystems", ParticleSystems, ParticleSystemClass);
+    TELEMETRY_RECORD("Waves", Waves, WaveClass);
+    TELEMETRY_RECORD("Bullets", Bullets, BulletClass);
+    TELEMETRY_RECORD("VoxelAnims", VoxelAnims, VoxelAnimClass);
+    TELEMETRY_RECORD("Terrains", Terrains, TerrainClass);
+    TELEMETRY_RECORD("Overlays", Overlays, OverlayClass);
+    TELEMETRY_RECORD("Smudges", Smudges, SmudgeClass);
+    TELEMETRY_RECORD("Factories", Factories, FactoryClass);
+    TELEMETRY_RECORD("Teams", Teams, TeamClass);
+    TELEMETRY_RECORD("Triggers", Triggers, TriggerClass);
+    TELEMETRY_RECORD("Tags", Tags, TagClass);
+    TELEMETRY_RECORD("EBolts", EBolts, EBoltClass);
+
+    /**
+     *  Extension instance lists.
+     */
+    TELEMETRY_RECORD("UnitExt", UnitExtensions, UnitClassExtension);
+    TELEMETRY_RECORD("InfantryExt", InfantryExtensions, InfantryClassExtension);
+    TELEMETRY_RECORD("BuildingExt", BuildingExtensions, BuildingClassExtension);
+    TELEMETRY_RECORD("AircraftExt", AircraftExtensions, AircraftClassExtension);
+    TELEMETRY_RECORD("AnimExt", AnimExtensions, AnimClassExtension);
+    TELEMETRY_RECORD("WaveExt", WaveExtensions, WaveClassExtension);
+    TELEMETRY_RECORD("TerrainExt", TerrainExtensions, TerrainClassExtension);
+    TELEMETRY_RECORD("OverlayExt", OverlayExtensions, OverlayClassExtension);
+    TELEMETRY_RECORD("SmudgeExt", SmudgeExtensions, SmudgeClassExtension);
+    TELEMETRY_RECORD("FactoryExt", FactoryExtensions, FactoryClassExtension);
+    TELEMETRY_RECORD("SuperExt", SuperExtensions, SuperClassExtension);
+
+    EntryCount = RecordIndex;
+
+    if (LogFile != nullptr && (Frame % LogInterval) == 0) {
+        Write_Log_Row();
+    }
+}
+
+
+/**
+ *  Clears all the sampled data, such as when a new scenario starts.
+ *
+ *  @author: CCHyper
+ */
+void MemoryTelemetry::Reset()
+{
+    std::memset(Entries, 0, sizeof(Entries));
+    EntryCount = 0;
+    RecordIndex = 0;
+    LastFrame = -1;
+    LastAllocationCount = Vinifera_Allocation_Count;
+    LastDeleteCount = Vinifera_Delete_Count;
+    AllocationsLastFrame = 0;
+    FreesLastFrame = 0;
+}
+
+
+/**
+ *  Stores the sample for the next heap in the list.
+ *
+ *  @author: CCHyper
+ */
+void MemoryTelemetry::Record(const char *name, int count, int element_size)
+{
+    ASSERT(RecordIndex < TELEMETRY_MAX_ENTRIES);
+
+    TelemetryEntry &entry = Entries[RecordIndex++];
+
+    /**
+     *  The first sample after a reset only establishes the baseline.
+     */
+    if (entry.Name == nullptr) {
+        entry.Name = name;
+        entry.Growth = 0;
+    } else {
+        entry.Growth = count - entry.Count;
+    }
+
+    entry.Count = count;
+    entry.Bytes = count * element_size;
+    entry.Peak = std::max(entry.Peak, count);
+}
+
+
+/**
+ *  Opens a new CSV log in the debug directory and starts streaming samples to it.
+ *
+ *  @author: CCHyper
+ */
+bool MemoryTelemetry::Start_Log()
+{
+    if (LogFile != nullptr) {
+        return true;
+    }
+
+    int day = 0;
+    int month = 0;
+    int year = 0;
+    int hour = 0;
+    int min = 0;
+    int sec = 0;
+
+    Get_Full_Time(day, month, year, hour, min, sec);
+
+    char filename_buffer[512];
+    std::snprintf(filename_buffer, sizeof(filename_buffer), "%s\\TELEMETRY_%02u-%02u-%04u_%02u-%02u-%02u.CSV",
+        Vinifera_DebugDirectory,
+        day, month, year, hour, min, sec);
+
+    LogFile = std::fopen(filename_buffer, "w+");
+    if (LogFile == nullptr) {
+        DEBUG_ERROR("Failed to open telemetry log file for writing!\n");
+        return false;
+    }
+
+    DEBUG_INFO("Writing memory telemetry to file %s.\n", filename_buffer);
+
+    /**
+     *  Make sure the column names are known before the header is written.
+     */
+    if (!EntryCount) {
+        LastFrame = -1;
+        Update();
+    }
+
+    Write_Log_Header();
+
+    return true;
+}
+
+
+/**
+ *  Flushes and closes the CSV log.
+ *
+ *  @author: CCHyper
+ */
+void MemoryTelemetry::Stop_Log()
+{
+    if (LogFile == nullptr) {
+        return;
+    }
+
+    std::fclose(LogFile);
+    LogFile = nullptr;
+
+    DEBUG_INFO("Memory telemetry log closed.\n");
+}
+
+
+/**
+ *  Writes the column names to the CSV log.
+ *
+ *  @author: CCHyper
+ */
+void MemoryTelemetry::Write_Log_Header()
+{
+    std::fprintf(LogFile, "Frame,LiveBytes,PeakBytes,Allocations,Frees");
+
+    for (int i = 0; i < EntryCount; ++i) {
+        const char *name = Entries[i].Name;
+        std::fprintf(LogFile, ",%s.Count,%s.Bytes,%s.NetGrowth,%s.Peak", name, name, name, name);
+    }
+
+    std::fprintf(LogFile, "\n");
+}
+
+
+/**
+ *  Writes the current sample as a row to the CSV log.
+ *
+ *  @author: CCHyper
+ */
+void MemoryTelemetry::Write_Log_Row()
+{
+    std::fprintf(LogFile, "%d,%u,%u,%d,%d", Frame,
+        Vinifera_Allocated_Bytes, Vinifera_Allocated_Bytes_Peak, AllocationsLastFrame, FreesLastFrame);
+
+    for (int i = 0; i < EntryCount; ++i) {
+        const TelemetryEntry &entry = Entries[i];
+        std::fprintf(LogFile, ",%d,%d,%d,%d", entry.Count, entry.Bytes, entry.Growth, entry.Peak);
+    }
+
+    std::fprintf(LogFile, "\n");
+
+    /**
+     *  Flush each row so the log survives a crash, which is exactly when it is most useful.
+     */
+    std::fflush(LogFile);
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************
+/*                 O P E N  S O U R C E  --  V I N I F E R A                  **
+/*******************************************************************************
+ *
+ *  @project       Vinifera
+ *
+ *  @file          MEMORYTELEMETRY.H
+ *
+ *  @author        CCHyper
+ *
+ *  @brief         Live memory and object count telemetry for developer mode.
+ *
+ *  @license       Vinifera is free software: you can redistribute it and/or
+ *                 modify it under the terms of the GNU General Public License
+ *                 as published by the Free Software Foundation, either version
+ *                 3 of the License, or (at your option) any later version.
+ *
+ *                 Vinifera is distributed in the hope that it will be
+ *                 useful, but WITHOUT ANY WARRANTY; without even the implied
+ *                 warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *                 PURPOSE. See the GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public
+ *                 License along with this program.
+ *                 If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#pragma once
+
+#include "always.h"
+#include <cstdio>
+
+
+#define TELEMETRY_MAX_ENTRIES 48
+
+
+/**
+ *  Snapshot of a single game heap or extension list.
+ */
+struct TelemetryEntry
+{
+    /**
+     *  Display name of the heap, also used as the CSV column prefix.
+     */
+    const char *Name;
+
+    /**
+     *  Number of live objects and the memory they occupy.
+     */
+    int Count;
+    int Bytes;
+
+    /**
+     *  Net change in the live object count since the previous sample, this
+     *  is zero when as many objects were destroyed as were created.
+     */
+    int Growth;
+
+    /**
+     *  The highest live object count seen since telemetry began.
+     */
+    int Peak;
+};
+
+
+class MemoryTelemetry
+{
+public:
+    MemoryTelemetry() = delete;
+
+    static void Update();
+    static void Reset();
+
+    static bool Start_Log();
+    static void Stop_Log();
+    static bool Is_Logging() { return LogFile != nullptr; }
+
+    static int Entry_Count() { return EntryCount; }
+    static const TelemetryEntry &Entry(int index) { return Entries[index]; }
+
+    static int Allocations_Last_Frame() { return AllocationsLastFrame; }
+    static int Frees_Last_Frame() { return FreesLastFrame; }
+
+    /**
+     *  How often (in game frames) a row is written to the CSV log.
+     */
+    static int LogInterval;
+
+private:
+    static void Record(const char *name, int count, int element_size);
+    static void Write_Log_Header();
+    static void Write_Log_Row();
+
+private:
+    /**
+     *  The sampled heaps, in the order they are recorded each frame.
+     */
+    static TelemetryEntry Entries[TELEMETRY_MAX_ENTRIES];
+    static int EntryCount;
+    static int RecordIndex;
+
+    /**
+     *  The frame of the last sample, so paused frames are not sampled twice.
+     */
+    static int LastFrame;
+
+    /**
+     *  Global allocator counters at the last sample, and the per-frame
+     *  difference computed from them.
+     */
+    static unsigned LastAllocationCount;
+    static int LastDeleteCount;
+    static int AllocationsLastFrame;
+    static int FreesLastFrame;
+
+    /**
+     *  The open CSV log, or null if logging is disabled.
+     */
+    static FILE *LogFile;
+};
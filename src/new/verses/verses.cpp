@@ -40,6 +40,15 @@ std::vector<std::vector<Verses::VersesData<bool>>> Verses::ForceFire;
 std::vector<std::vector<Verses::VersesData<bool>>> Verses::PassiveAcquire;
 std::vector<std::vector<Verses::VersesData<bool>>> Verses::Retaliate;
 
+bool Verses::IsResolved = false;
+bool Verses::IsStale = false;
+int Verses::ResolvedArmorCount = 0;
+int Verses::ResolvedWarheadCount = 0;
+std::vector<double> Verses::ResolvedModifier;
+std::vector<unsigned char> Verses::ResolvedForceFire;
+std::vector<unsigned char> Verses::ResolvedPassiveAcquire;
+std::vector<unsigned char> Verses::ResolvedRetaliate;
+
 /**
  *  Saves all the Verses arrays to the stream.
  *
@@ -84,6 +93,11 @@ HRESULT Verses::Load(IStream* pStm)
         return hr;
 
     hr = Load_2D_Vector(pStm, Retaliate, "Verses::Retaliate");
+    if (FAILED(hr))
+        return hr;
+
+    Resolve();
+
     return hr;
 }
 
@@ -95,6 +109,9 @@ HRESULT Verses::Load(IStream* pStm)
  */
 void Verses::Resize()
 {
+    IsResolved = false;
+    IsStale = true;
+
     const int old_armor_count = Modifier.size();
 
     // Add new arrays for new armors
@@ -130,6 +147,9 @@ void Verses::Resize()
  */
 void Verses::Clear()
 {
+    IsResolved = false;
+    IsStale = false;
+
     Modifier.clear();
     ForceFire.clear();
     PassiveAcquire.clear();
@@ -137,6 +157,82 @@ void Verses::Clear()
 }
 
 
+/**
+ *  Builds the resolved lookup tables from the current Verses arrays. This is
+ *  done once all the armors and warheads have been read, and again on the
+ *  next lookup whenever the arrays change afterwards (for example when a
+ *  warhead is first referenced by a later INI).
+ *
+ *  @author: CCHyper
+ */
+void Verses::Resolve()
+{
+    IsResolved = false;
+    IsStale = false;
+
+    if (Modifier.size() != ArmorTypes.Count()) {
+        return;
+    }
+
+    /**
+     *  Wait for the arrays to be resized if a warhead was added since.
+     */
+    for (int armor = ARMOR_FIRST; armor < Modifier.size(); armor++) {
+        if (Modifier[armor].size() != WarheadTypes.Count()) {
+            return;
+        }
+    }
+
+    ResolvedArmorCount = ArmorTypes.Count();
+    ResolvedWarheadCount = WarheadTypes.Count();
+
+    Resolve_Table(Modifier, &ArmorTypeClass::Modifier, ResolvedModifier);
+    Resolve_Table(ForceFire, &ArmorTypeClass::ForceFire, ResolvedForceFire);
+    Resolve_Table(PassiveAcquire, &ArmorTypeClass::PassiveAcquire, ResolvedPassiveAcquire);
+    Resolve_Table(Retaliate, &ArmorTypeClass::Retaliate, ResolvedRetaliate);
+
+    IsResolved = true;
+}
+
+
+/**
+ *  Fetches the index of the warhead in the Verses arrays.
+ *
+ *  @author: CCHyper
+ */
+WarheadType Verses::Warhead_Index(const WarheadTypeClass* warhead)
+{
+    /**
+     *  The heap index of the warhead is its index in the Verses arrays, only
+     *  search the warhead heap if the index does not match.
+     */
+    const int index = warhead->HeapID;
+    if (index >= WARHEAD_FIRST && index < WarheadTypes.Count() && WarheadTypes[index] == warhead) {
+        return static_cast<WarheadType>(index);
+    }
+
+    return static_cast<WarheadType>(WarheadTypes.ID(const_cast<WarheadTypeClass*>(warhead)));
+}
+
+
+/**
+ *  Flattens a Verses array into its resolved lookup table.
+ *
+ *  @author: CCHyper
+ */
+template <typename T, typename R>
+void Verses::Resolve_Table(std::vector<std::vector<VersesData<T>>>& vector, T ArmorTypeClass::* specific, std::vector<R>& resolved)
+{
+    resolved.resize(ArmorTypes.Count() * ResolvedWarheadCount);
+
+    for (ArmorType armor = ARMOR_FIRST; armor < ArmorTypes.Count(); armor++) {
+        for (int warhead = WARHEAD_FIRST; warhead < ResolvedWarheadCount; warhead++) {
+            resolved[(armor * ResolvedWarheadCount) + warhead] = Get_Value(armor, static_cast<WarheadType>(warhead), vector, specific);
+        }
+    }
+}
+
+
 /**
  *  Saves a 2D std::vector to the stream
  *
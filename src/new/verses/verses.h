@@ -61,31 +61,59 @@ public:
     static void Resize();
     static void Clear();
 
+    static void Resolve();
+
     static void Set_Modifier(ArmorType armor, WarheadType warhead, double value) { Set_Value(armor, warhead, value, Modifier); }
-    static double Get_Modifier(ArmorType armor, WarheadType warhead) { return Get_Value(armor, warhead, Modifier, &ArmorTypeClass::Modifier); }
+    static double Get_Modifier(ArmorType armor, WarheadType warhead) { return Is_Resolved(armor, warhead) ? ResolvedModifier[Resolved_Index(armor, warhead)] : Get_Value(armor, warhead, Modifier, &ArmorTypeClass::Modifier); }
 
-    static void Set_Modifier(ArmorType armor, WarheadTypeClass* warhead, double value) { Set_Modifier(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead)), value); }
-    static double Get_Modifier(ArmorType armor, WarheadTypeClass* warhead) { return Get_Modifier(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead))); }
+    static void Set_Modifier(ArmorType armor, const WarheadTypeClass* warhead, double value) { Set_Modifier(armor, Warhead_Index(warhead), value); }
+    static double Get_Modifier(ArmorType armor, const WarheadTypeClass* warhead) { return Get_Modifier(armor, Warhead_Index(warhead)); }
 
     static void Set_ForceFire(ArmorType armor, WarheadType warhead, bool value) { Set_Value(armor, warhead, value, ForceFire); }
-    static bool Get_ForceFire(ArmorType armor, WarheadType warhead) { return Get_Value(armor, warhead, ForceFire, &ArmorTypeClass::ForceFire); }
+    static bool Get_ForceFire(ArmorType armor, WarheadType warhead) { return Is_Resolved(armor, warhead) ? ResolvedForceFire[Resolved_Index(armor, warhead)] : Get_Value(armor, warhead, ForceFire, &ArmorTypeClass::ForceFire); }
 
-    static void Set_ForceFire(ArmorType armor, WarheadTypeClass* warhead, bool value) { Set_ForceFire(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead)), value); }
-    static bool Get_ForceFire(ArmorType armor, WarheadTypeClass* warhead) { return Get_ForceFire(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead))); }
+    static void Set_ForceFire(ArmorType armor, const WarheadTypeClass* warhead, bool value) { Set_ForceFire(armor, Warhead_Index(warhead), value); }
+    static bool Get_ForceFire(ArmorType armor, const WarheadTypeClass* warhead) { return Get_ForceFire(armor, Warhead_Index(warhead)); }
 
     static void Set_PassiveAcquire(ArmorType armor, WarheadType warhead, bool value) { Set_Value(armor, warhead, value, PassiveAcquire); }
-    static bool Get_PassiveAcquire(ArmorType armor, WarheadType warhead) { return Get_Value(armor, warhead, PassiveAcquire, &ArmorTypeClass::PassiveAcquire); }
+    static bool Get_PassiveAcquire(ArmorType armor, WarheadType warhead) { return Is_Resolved(armor, warhead) ? ResolvedPassiveAcquire[Resolved_Index(armor, warhead)] : Get_Value(armor, warhead, PassiveAcquire, &ArmorTypeClass::PassiveAcquire); }
 
-    static void Set_PassiveAcquire(ArmorType armor, WarheadTypeClass* warhead, bool value) { Set_PassiveAcquire(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead)), value); }
-    static bool Get_PassiveAcquire(ArmorType armor, WarheadTypeClass* warhead) { return Get_PassiveAcquire(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead))); }
+    static void Set_PassiveAcquire(ArmorType armor, const WarheadTypeClass* warhead, bool value) { Set_PassiveAcquire(armor, Warhead_Index(warhead), value); }
+    static bool Get_PassiveAcquire(ArmorType armor, const WarheadTypeClass* warhead) { return Get_PassiveAcquire(armor, Warhead_Index(warhead)); }
 
     static void Set_Retaliate(ArmorType armor, WarheadType warhead, bool value) { Set_Value(armor, warhead, value, Retaliate); }
-    static bool Get_Retaliate(ArmorType armor, WarheadType warhead) { return Get_Value(armor, warhead, Retaliate, &ArmorTypeClass::Retaliate); }
+    static bool Get_Retaliate(ArmorType armor, WarheadType warhead) { return Is_Resolved(armor, warhead) ? ResolvedRetaliate[Resolved_Index(armor, warhead)] : Get_Value(armor, warhead, Retaliate, &ArmorTypeClass::Retaliate); }
 
-    static void Set_Retaliate(ArmorType armor, WarheadTypeClass* warhead, bool value) { Set_Retaliate(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead)), value); }
-    static bool Get_Retaliate(ArmorType armor, WarheadTypeClass* warhead) { return Get_Retaliate(armor, static_cast<WarheadType>(WarheadTypes.ID(warhead))); }
+    static void Set_Retaliate(ArmorType armor, const WarheadTypeClass* warhead, bool value) { Set_Retaliate(armor, Warhead_Index(warhead), value); }
+    static bool Get_Retaliate(ArmorType armor, const WarheadTypeClass* warhead) { return Get_Retaliate(armor, Warhead_Index(warhead)); }
 
 private:
+    static WarheadType Warhead_Index(const WarheadTypeClass* warhead);
+
+    /**
+     *  Only use the resolved tables for pairs they cover, anything else (such as
+     *  WARHEAD_NONE) takes the original lookup path. Stale tables are rebuilt on
+     *  the first lookup after a change.
+     */
+    static bool Is_Resolved(ArmorType armor, WarheadType warhead)
+    {
+        if (IsStale) {
+            Resolve();
+        }
+
+        return IsResolved
+            && armor >= ARMOR_FIRST && armor < ResolvedArmorCount
+            && warhead >= WARHEAD_FIRST && warhead < ResolvedWarheadCount;
+    }
+
+    static int Resolved_Index(ArmorType armor, WarheadType warhead)
+    {
+        return (armor * ResolvedWarheadCount) + warhead;
+    }
+
+    template <typename T, typename R>
+    static void Resolve_Table(std::vector<std::vector<VersesData<T>>>& vector, T ArmorTypeClass::* specific, std::vector<R>& resolved);
+
     template <typename T>
     static void Set_Value(ArmorType armor, WarheadType warhead, T value, std::vector<std::vector<VersesData<T>>>& vector);
 
@@ -112,6 +140,21 @@ private:
     static std::vector<std::vector<VersesData<bool>>> ForceFire;
     static std::vector<std::vector<VersesData<bool>>> PassiveAcquire;
     static std::vector<std::vector<VersesData<bool>>> Retaliate;
+
+    /**
+     *  Flattened copies of the tables above with the base armor and default
+     *  fallbacks already applied, so lookups on hot paths (target evaluation,
+     *  damage calculation) are a single array access. Only valid while
+     *  IsResolved is set; any change to the source tables marks them as stale.
+     */
+    static bool IsResolved;
+    static bool IsStale;
+    static int ResolvedArmorCount;
+    static int ResolvedWarheadCount;
+    static std::vector<double> ResolvedModifier;
+    static std::vector<unsigned char> ResolvedForceFire;
+    static std::vector<unsigned char> ResolvedPassiveAcquire;
+    static std::vector<unsigned char> ResolvedRetaliate;
 };
 
 
@@ -128,6 +171,12 @@ void Verses::Set_Value(ArmorType armor, WarheadType warhead, T value, std::vecto
 
     vector[armor][warhead].Value = value;
     vector[armor][warhead].IsSet = true;
+
+    /**
+     *  The value may be inherited by other armors, so the resolved tables are now stale.
+     */
+    IsResolved = false;
+    IsStale = true;
 }
 
 
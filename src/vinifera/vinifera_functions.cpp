@@ -57,14 +57,21 @@
 #include "debughandler.h"
 #include "asserthandler.h"
 #include <string>
+#include <algorithm>
 
 #include "aircrafttracker.h"
 #include "rocketlocomotion.h"
 #include "newjumpjetlocomotion.h"
 #include "prerequisitegroup.h"
+#include "memorytelemetry.h"
+#include "stackdump.h"
+#include "cpudispatch.h"
 #include "setup_hooks.h"
 
 
+extern char Execute_Time_Buffer[256];
+
+
 static DynamicVectorClass<Wstring> ViniferaSearchPaths;
 
 
@@ -137,6 +144,20 @@ bool Vinifera_Load_INI()
 
     Vinifera_NoVersionString = ini.Get_Bool("General", "NoVersionString", Vinifera_NoVersionString);
 
+    MemoryTelemetry::LogInterval = std::max(1, ini.Get_Int("General", "TelemetryLogInterval", MemoryTelemetry::LogInterval));
+
+    /**
+     *  The command line takes priority over the INI.
+     */
+    if (!CPUDispatchClass::Is_Tier_Forced() && ini.Get_String("General", "CPUTier", buffer, sizeof(buffer)) > 0) {
+        CPUTierType tier = CPUDispatchClass::Tier_From_Name(buffer);
+        if (tier != CPU_TIER_NONE) {
+            CPUDispatchClass::Force_Tier(tier);
+        } else {
+            DEBUG_WARNING("Unknown CPUTier \"%s\" in VINIFERA.INI!\n", buffer);
+        }
+    }
+
     Vinifera_NewSidebar = ini.Get_Bool("Features", "NewSidebar", false);
     ini.Get_String("General", "SavedGamesDirectory", buffer, std::size(buffer));
     if (std::strlen(buffer) > 0) {
@@ -412,6 +433,31 @@ bool Vinifera_Parse_Command_Line(int argc, char *argv[])
             continue;
         }
 
+        /**
+         *  Write module relative addresses in stack dumps instead of resolving symbols?
+         */
+        if (stricmp(string, "-RAW_STACK_DUMPS") == 0) {
+            char filename[PATH_MAX];
+            std::snprintf(filename, sizeof(filename), "%s\\STACK_RAW_%s.LOG", Vinifera_DebugDirectory, Execute_Time_Buffer);
+            DEBUG_INFO("  - Stack dumps write raw addresses to \"%s\".\n", filename);
+            Stack_Dump_Set_Raw(filename);
+            continue;
+        }
+
+        /**
+         *  Limit the instruction set used by the dispatched routines.
+         */
+        if (strnicmp(string, "-CPU_TIER=", 10) == 0) {
+            CPUTierType tier = CPUDispatchClass::Tier_From_Name(&string[10]);
+            if (tier != CPU_TIER_NONE) {
+                DEBUG_INFO("  - Limiting CPU tier to %s.\n", CPUDispatchClass::Name_From_Tier(tier));
+                CPUDispatchClass::Force_Tier(tier);
+            } else {
+                DEBUG_WARNING("  - Unknown CPU tier \"%s\"!\n", &string[10]);
+            }
+            continue;
+        }
+
         /**
          *  Are file io errors fatal?
          */
@@ -552,6 +598,12 @@ bool Vinifera_Startup()
 #endif
     }
 
+    /**
+     *  Select the instruction set variants of the dispatched routines now
+     *  that any user override is known.
+     */
+    CPUDispatchClass::Bind_All();
+
     DEBUG_INFO("Setting up conditional hooks.\n");
     Setup_Conditional_Hooks();
 
@@ -694,7 +746,10 @@ bool Vinifera_Shutdown()
     delete AircraftTracker;
     AircraftTracker = nullptr;
 
+    MemoryTelemetry::Stop_Log();
+
     DEV_DEBUG_INFO("Shutdown - New Count: %d, Delete Count: %d\n", Vinifera_New_Count, Vinifera_Delete_Count);
+    DEV_DEBUG_INFO("Shutdown - Live Bytes: %u, Peak Bytes: %u\n", Vinifera_Allocated_Bytes, Vinifera_Allocated_Bytes_Peak);
 
     return true;
 }
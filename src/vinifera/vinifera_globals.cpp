@@ -62,6 +62,7 @@ bool Vinifera_Developer_FrameStep = false;
 int Vinifera_Developer_FrameStepCount = 0;
 bool Vinifera_Developer_AIControl = false;
 bool Vinifera_Developer_IsToReloadRules = false;
+bool Vinifera_Developer_ShowStatistics = false;
 
 bool Vinifera_SkipLogoMovies = false;
 bool Vinifera_SkipStartupMovies = false;
@@ -84,6 +84,7 @@ extern bool Vinifera_Developer_FrameStep;
 extern int Vinifera_Developer_FrameStepCount;
 extern bool Vinifera_Developer_AIControl;
 extern bool Vinifera_Developer_IsToReloadRules;
+extern bool Vinifera_Developer_ShowStatistics;
 
 
 /**
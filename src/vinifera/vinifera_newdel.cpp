@@ -29,6 +29,7 @@
 #include "debughandler.h"
 #include "newdel.h" // TS++ new and delete wrappers.
 #include <new>
+#include <algorithm>
 
 #include "asserthandler.h"
 #include "debughandler.h"
@@ -39,6 +40,9 @@
 
 int Vinifera_New_Count = 0;
 int Vinifera_Delete_Count = 0;
+unsigned Vinifera_Allocation_Count = 0;
+unsigned Vinifera_Allocated_Bytes = 0;
+unsigned Vinifera_Allocated_Bytes_Peak = 0;
 
 
 /**
@@ -50,6 +54,51 @@ static unsigned Round_Up(unsigned number, int a)
 }
 
 
+/**
+ *  Records a change in the number of bytes currently allocated by our wrappers.
+ * 
+ *  @note: This is reached from any thread that uses new or delete, so the
+ *         counters are updated with interlocked operations.
+ */
+static void Track_Allocated_Bytes(unsigned added, unsigned removed)
+{
+    const LONG delta = LONG(added - removed);
+    const unsigned current = unsigned(InterlockedExchangeAdd((volatile LONG *)&Vinifera_Allocated_Bytes, delta) + delta);
+
+    /**
+     *  Blocks allocated before tracking started can make the count drop
+     *  below zero when freed, do not treat that as a new peak.
+     */
+    if (LONG(current) < 0) {
+        return;
+    }
+
+    LONG peak = LONG(Vinifera_Allocated_Bytes_Peak);
+    while (LONG(current) > peak) {
+        const LONG previous = InterlockedCompareExchange((volatile LONG *)&Vinifera_Allocated_Bytes_Peak, LONG(current), peak);
+        if (previous == peak) {
+            break;
+        }
+        peak = previous;
+    }
+}
+
+
+/**
+ *  Fetches the size of a heap block for the live byte count. Querying the heap
+ *  takes the heap lock, so this is only done when the developer overlay and
+ *  telemetry that use the count are available.
+ */
+static unsigned Tracked_Block_Size(void *ptr)
+{
+    if (!Vinifera_DeveloperMode || ptr == nullptr) {
+        return 0;
+    }
+
+    return unsigned(HeapSize(GetProcessHeap(), 0, ptr));
+}
+
+
 /**
  *  Implement wrappers for C memory functions.
  */
@@ -65,6 +114,11 @@ void * __cdecl vinifera_allocate(unsigned int size)
 
     ++Vinifera_New_Count;
 
+    if (Vinifera_DeveloperMode) {
+        InterlockedIncrement((volatile LONG *)&Vinifera_Allocation_Count);
+        Track_Allocated_Bytes(r_size, 0);
+    }
+
     return block_ptr;
 }
 
@@ -78,6 +132,11 @@ void * __cdecl vinifera_count_allocate(unsigned int count, unsigned int size)
     void *block_ptr = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, r_size * count);
     ASSERT_STACKDUMP_PRINT(block_ptr != nullptr, "Failed to allocate memory!\n");
 
+    if (Vinifera_DeveloperMode) {
+        InterlockedIncrement((volatile LONG *)&Vinifera_Allocation_Count);
+        Track_Allocated_Bytes(r_size * count, 0);
+    }
+
     return block_ptr;
 }
 
@@ -88,19 +147,34 @@ void * __cdecl vinifera_reallocate(void *ptr, unsigned int size)
      */
     unsigned r_size = Round_Up(size, 4);
 
+    unsigned old_size = Tracked_Block_Size(ptr);
+
     void *block_ptr = HeapReAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, ptr, r_size);
     ASSERT_STACKDUMP_PRINT(block_ptr != nullptr, "Failed to allocate memory!\n");
 
+    if (Vinifera_DeveloperMode) {
+        Track_Allocated_Bytes(r_size, old_size);
+    }
+
     return block_ptr;
 }
 
 void __cdecl vinifera_free(void *ptr)
 {
+    /**
+     *  Fetch the block size before it is released so the live byte count stays accurate.
+     */
+    unsigned size = Tracked_Block_Size(ptr);
+
     bool freed = HeapFree(GetProcessHeap(), HEAP_ZERO_MEMORY, ptr);
     ASSERT_STACKDUMP_PRINT(freed, "Failed to free memory!\n");
 
     ++Vinifera_Delete_Count;
 
+    if (Vinifera_DeveloperMode) {
+        Track_Allocated_Bytes(0, size);
+    }
+
     ASSERT(freed);
 }
 
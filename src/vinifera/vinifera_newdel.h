@@ -99,6 +99,9 @@
 
 extern int Vinifera_New_Count;
 extern int Vinifera_Delete_Count;
+extern unsigned Vinifera_Allocation_Count;
+extern unsigned Vinifera_Allocated_Bytes;
+extern unsigned Vinifera_Allocated_Bytes_Peak;
 
 void * __cdecl vinifera_allocate(unsigned int size);
 void * __cdecl vinifera_count_allocate(unsigned int count, unsigned int size);
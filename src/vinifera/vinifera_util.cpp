@@ -44,7 +44,11 @@
 #include "minidump.h"
 #include "winutil.h"
 #include "xzip.h"
+#include "rawfile.h"
+#include <climits>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 
 extern char Execute_Time_Buffer[256];
@@ -480,16 +484,100 @@ const char *Vinifera_Get_Window_Title(DWORD dwPid)
 }
 
 
+/**
+ *  Size and age of a file that is about to be archived.
+ */
+typedef struct ZipFileInfoStruct
+{
+    FILETIME WriteTime;
+    unsigned Size;
+    bool Checked;
+    bool Selected;
+} ZipFileInfoStruct;
+
+
 /**
  *  Creates a zip file is the specified files.
  * 
  *  @note: If the zip file already exists, it will be updated.
  * 
+ *  @note: Files are streamed into the archive from disk, so memory use does not
+ *         grow with the size of the input. If a size limit is given, the files
+ *         are picked newest first (by last write time) until the limit is reached,
+ *         and any older file that would not fit is left out.
+ * 
+ *  @note: If "added" is given, it receives for each file in the list whether
+ *         the file was added to the archive.
+ * 
  *  @author: CCHyper
  */
-bool Vinifera_Create_Zip(const char *filename, DynamicVectorClass<const char *> &filelist, const char *path)
+bool Vinifera_Create_Zip(const char *filename, DynamicVectorClass<const char *> &filelist, const char *path, unsigned max_bytes, ZipProgressCallbackType progress, bool *added)
 {
     char buffer[PATH_MAX];
+    const int count = filelist.Count();
+
+    if (added) {
+        for (int i = 0; i < count; ++i) {
+            added[i] = false;
+        }
+    }
+
+    ZipFileInfoStruct *info = new ZipFileInfoStruct[count];
+
+    for (int i = 0; i < count; ++i) {
+        if (path) {
+            std::snprintf(buffer, sizeof(buffer), "%s\\%s", path, filelist[i]);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), ".\\%s", filelist[i]);
+        }
+
+        std::memset(&info[i], 0, sizeof(info[i]));
+        info[i].Selected = true;
+
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (GetFileAttributesEx(buffer, GetFileExInfoStandard, &attributes)) {
+            info[i].WriteTime = attributes.ftLastWriteTime;
+            info[i].Size = attributes.nFileSizeHigh ? UINT_MAX : attributes.nFileSizeLow;
+        }
+    }
+
+    /**
+     *  Fill the size limit with the newest files first, so a long session
+     *  does not push out the files written at the time of the crash.
+     */
+    if (max_bytes) {
+        unsigned total_bytes = 0;
+
+        for (int i = 0; i < count; ++i) {
+            info[i].Selected = false;
+        }
+
+        while (true) {
+            int newest = -1;
+            for (int i = 0; i < count; ++i) {
+                if (info[i].Checked) {
+                    continue;
+                }
+                if (newest == -1 || CompareFileTime(&info[i].WriteTime, &info[newest].WriteTime) > 0) {
+                    newest = i;
+                }
+            }
+
+            if (newest == -1) {
+                break;
+            }
+
+            info[newest].Checked = true;
+
+            if (info[newest].Size > (max_bytes - total_bytes)) {
+                DEBUG_WARNING("Skipping \"%s\", archive size limit reached.\n", filelist[newest]);
+                continue;
+            }
+
+            total_bytes += info[newest].Size;
+            info[newest].Selected = true;
+        }
+    }
     
     if (path) {
         std::snprintf(buffer, sizeof(buffer), "%s\\%s", path, filename);
@@ -500,24 +588,45 @@ bool Vinifera_Create_Zip(const char *filename, DynamicVectorClass<const char *>
     HZIP hZip = CreateZip((void *)buffer, 0, ZIP_FILENAME);
     if (!hZip) {
         DEBUG_ERROR("Failed to create zip archive \"%s\"!\n", filename);
+        delete [] info;
         return false;
     }
 
-    /**
-     *  
-     */
-    for (int i = 0; i < filelist.Count(); ++i) {
+    for (int i = 0; i < count; ++i) {
+        if (!info[i].Selected) {
+            continue;
+        }
+
         if (path) {
             std::snprintf(buffer, sizeof(buffer), "%s\\%s", path, filelist[i]);
         } else {
             std::snprintf(buffer, sizeof(buffer), ".\\%s", filelist[i]);
         }
+
+        if (progress) {
+            progress(i, count, filelist[i]);
+        }
+
+        /**
+         *  A file that can not be read (i.e. it is still open for writing) is
+         *  left out and stays on disk, the rest of the archive is still written.
+         */
         ZRESULT zresult = ZipAdd(hZip, filelist[i], buffer, 0, ZIP_FILENAME);
         if (zresult != ZR_OK) {
-            DEBUG_ERROR("Failed to add file \"%s\" to zip archive \"%s\"!\n", buffer, filename);
-            return false;
+            DEBUG_WARNING("Failed to add file \"%s\" to zip archive \"%s\"!\n", buffer, filename);
+            continue;
+        }
+
+        if (added) {
+            added[i] = true;
         }
     }
+
+    delete [] info;
+
+    if (progress) {
+        progress(count, count, nullptr);
+    }
     
     DEBUG_INFO("Zip archive \"%s\" created sucessfully.\n", filename);
 
@@ -526,78 +635,225 @@ bool Vinifera_Create_Zip(const char *filename, DynamicVectorClass<const char *>
 
 
 /**
- *  Collects the debug files from this session and creates a zip file.
+ *  Parameters for a zip archive being created on a worker thread.
+ */
+typedef struct CreateZipParamsStruct
+{
+    char Filename[PATH_MAX];
+    char Path[PATH_MAX];
+    bool HasPath;
+    DynamicVectorClass<const char *> FileList;
+    unsigned MaxBytes;
+    ZipProgressCallbackType Progress;
+    bool MoveFiles;
+} CreateZipParamsStruct;
+
+
+/**
+ *  Takes a copy of the zip parameters, so the caller is free to release theirs.
  * 
- *  @note: If the zip file already exists, it will be updated.
+ *  @author: CCHyper
+ */
+static CreateZipParamsStruct *Vinifera_Create_Zip_Params(const char *filename, DynamicVectorClass<const char *> &filelist, const char *path, unsigned max_bytes, ZipProgressCallbackType progress, bool move_files)
+{
+    CreateZipParamsStruct *params = new CreateZipParamsStruct;
+
+    std::strncpy(params->Filename, filename, sizeof(params->Filename)-1);
+    params->Filename[sizeof(params->Filename)-1] = '\0';
+
+    params->HasPath = (path != nullptr);
+    if (path) {
+        std::strncpy(params->Path, path, sizeof(params->Path)-1);
+        params->Path[sizeof(params->Path)-1] = '\0';
+    }
+
+    for (int i = 0; i < filelist.Count(); ++i) {
+        params->FileList.Add(strdup(filelist[i]));
+    }
+
+    params->MaxBytes = max_bytes;
+    params->Progress = progress;
+    params->MoveFiles = move_files;
+
+    return params;
+}
+
+
+/**
+ *  Releases the zip parameters.
  * 
  *  @author: CCHyper
  */
-bool Vinifera_Collect_Debug_Files()
+static void Vinifera_Free_Zip_Params(CreateZipParamsStruct *params)
+{
+    for (int i = 0; i < params->FileList.Count(); ++i) {
+        std::free((void *)params->FileList[i]);
+    }
+    delete params;
+}
+
+
+/**
+ *  Worker thread entry point for Vinifera_Create_Zip_Async.
+ * 
+ *  @note: This takes ownership of the parameters.
+ * 
+ *  @author: CCHyper
+ */
+static DWORD WINAPI Vinifera_Create_Zip_Thread(LPVOID lpParameter)
 {
-#if 0
     char buffer[PATH_MAX];
 
-    char debug_buffer[PATH_MAX];
-    char except_buffer[PATH_MAX];
-    char stack_buffer[PATH_MAX];
-    char crashdump_buffer[PATH_MAX];
+    CreateZipParamsStruct *params = reinterpret_cast<CreateZipParamsStruct *>(lpParameter);
+    const char *path = params->HasPath ? params->Path : nullptr;
 
-    RawFileClass tmpfile;
-    DynamicVectorClass<const char *> files;
+    bool *added = new bool[params->FileList.Count()];
+
+    bool result = Vinifera_Create_Zip(params->Filename, params->FileList, path, params->MaxBytes, params->Progress, added);
 
-    std::snprintf(debug_buffer, sizeof(debug_buffer), "%s\\DEBUG_%s.LOG", Vinifera_DebugDirectory, Execute_Time_Buffer);
-    tmpfile.Set_Name(debug_buffer);
-    if (tmpfile.Is_Available()) {
-        std::snprintf(buffer, sizeof(buffer), "DEBUG_%s.LOG", Execute_Time_Buffer);
-        files.Add(strdup(buffer));
+    /**
+     *  Remove the files that made it into the archive, anything that was
+     *  left out stays on disk.
+     */
+    if (result && params->MoveFiles) {
+        for (int i = 0; i < params->FileList.Count(); ++i) {
+            if (!added[i]) {
+                continue;
+            }
+            if (path) {
+                std::snprintf(buffer, sizeof(buffer), "%s\\%s", path, params->FileList[i]);
+            } else {
+                std::snprintf(buffer, sizeof(buffer), ".\\%s", params->FileList[i]);
+            }
+            RawFileClass(buffer).Delete();
+        }
     }
 
-    std::snprintf(except_buffer, sizeof(except_buffer), "%s\\EXCEPT_%s.TXT", Vinifera_DebugDirectory, Execute_Time_Buffer);
-    tmpfile.Set_Name(except_buffer);
-    if (tmpfile.Is_Available()) {
-        std::snprintf(buffer, sizeof(buffer), "EXCEPT_%s.TXT", Execute_Time_Buffer);
-        files.Add(strdup(buffer));
+    delete [] added;
+    Vinifera_Free_Zip_Params(params);
+
+    return result ? 1 : 0;
+}
+
+
+/**
+ *  Creates a zip file of the specified files on a worker thread.
+ * 
+ *  Returns the handle of the worker thread, the exit code of which is non-zero
+ *  if the archive was created. The caller is responsible for closing the handle.
+ * 
+ *  @note: The progress callback is invoked from the worker thread. If "move_files"
+ *         is set, the files that were added to the archive are deleted afterwards.
+ * 
+ *  @author: CCHyper
+ */
+HANDLE Vinifera_Create_Zip_Async(const char *filename, DynamicVectorClass<const char *> &filelist, const char *path, unsigned max_bytes, ZipProgressCallbackType progress, bool move_files)
+{
+    CreateZipParamsStruct *params = Vinifera_Create_Zip_Params(filename, filelist, path, max_bytes, progress, move_files);
+
+    HANDLE thread = CreateThread(nullptr, 0, &Vinifera_Create_Zip_Thread, params, 0, nullptr);
+    if (!thread) {
+        DEBUG_ERROR("Failed to create zip worker thread!\n");
+        Vinifera_Free_Zip_Params(params);
+        return nullptr;
     }
 
-    std::snprintf(stack_buffer, sizeof(stack_buffer), "%s\\STACK_%s.LOG", Vinifera_DebugDirectory, Execute_Time_Buffer);
-    tmpfile.Set_Name(stack_buffer);
-    if (tmpfile.Is_Available()) {
-        std::snprintf(buffer, sizeof(buffer), "STACK_%s.LOG", Execute_Time_Buffer);
-        files.Add(strdup(buffer));
+    return thread;
+}
+
+
+/**
+ *  Reports the progress of the debug file collection.
+ * 
+ *  @note: This is written to the debugger output rather than the log, as the
+ *         session log itself is one of the files being archived.
+ * 
+ *  @author: CCHyper
+ */
+static void Vinifera_Collect_Debug_Files_Progress(int index, int count, const char *filename)
+{
+    char buffer[PATH_MAX];
+
+    if (filename) {
+        std::snprintf(buffer, sizeof(buffer), "Collecting debug files (%d/%d) \"%s\"...\n", index+1, count, filename);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "Collecting debug files (%d/%d) done.\n", count, count);
     }
 
+    OutputDebugString(buffer);
+}
+
+
+/**
+ *  Collects the debug files from this session and creates a zip file.
+ * 
+ *  @note: If the zip file already exists, it will be updated.
+ * 
+ *  @note: The archive is built on a worker thread, and the wait for it is
+ *         limited so a stalled archive can not hold up the caller. If "async"
+ *         is false (i.e. while the loader lock is held), it is built on the
+ *         calling thread instead.
+ * 
+ *  @author: CCHyper
+ */
+bool Vinifera_Collect_Debug_Files(bool async)
+{
+    char buffer[PATH_MAX];
+
+    enum { DEBUG_FILE_COUNT = 5 };
+    char filenames[DEBUG_FILE_COUNT][PATH_MAX];
+
     const char *module_name = strupr((char *)Get_Module_File_Name());
-    std::snprintf(crashdump_buffer, sizeof(crashdump_buffer), "%s\\CRASHDUMP_%s_%s.DMP", Vinifera_DebugDirectory, module_name, Execute_Time_Buffer);
-    tmpfile.Set_Name(crashdump_buffer);
-    if (tmpfile.Is_Available()) {
-        std::snprintf(buffer, sizeof(buffer), "CRASHDUMP_%s_%s.DMP", module_name, Execute_Time_Buffer);
-        files.Add(strdup(buffer));
+    std::snprintf(filenames[0], sizeof(filenames[0]), "DEBUG_%s.LOG", Execute_Time_Buffer);
+    std::snprintf(filenames[1], sizeof(filenames[1]), "EXCEPT_%s.TXT", Execute_Time_Buffer);
+    std::snprintf(filenames[2], sizeof(filenames[2]), "STACK_%s.LOG", Execute_Time_Buffer);
+    std::snprintf(filenames[3], sizeof(filenames[3]), "CRASHDUMP_%s_%s.DMP", module_name, Execute_Time_Buffer);
+    std::snprintf(filenames[4], sizeof(filenames[4]), "STACK_RAW_%s.LOG", Execute_Time_Buffer);
+
+    RawFileClass tmpfile;
+    DynamicVectorClass<const char *> files;
+
+    for (int i = 0; i < DEBUG_FILE_COUNT; ++i) {
+        std::snprintf(buffer, sizeof(buffer), "%s\\%s", Vinifera_DebugDirectory, filenames[i]);
+        tmpfile.Set_Name(buffer);
+        if (tmpfile.Is_Available()) {
+            files.Add(filenames[i]);
+        }
+    }
+
+    if (!files.Count()) {
+        return true;
     }
 
     std::snprintf(buffer, sizeof(buffer), "%s_%s.ZIP", "DEBUG", Execute_Time_Buffer);
-    bool result = Vinifera_Create_Zip(buffer, files, Vinifera_DebugDirectory);
 
-    /**
-     *  Cleanup files.
-     */
-    if (result) {
-        RawFileClass(debug_buffer).Delete();
-        RawFileClass(except_buffer).Delete();
-        RawFileClass(stack_buffer).Delete();
-        RawFileClass(crashdump_buffer).Delete();
-    }
+    if (async) {
+        HANDLE thread = Vinifera_Create_Zip_Async(buffer, files, Vinifera_DebugDirectory, DEBUG_ARCHIVE_MAX_BYTES, &Vinifera_Collect_Debug_Files_Progress, true);
+        if (thread) {
+
+            /**
+             *  The worker owns a copy of everything it uses, so if the wait
+             *  times out it is safe to leave it behind. The files are only
+             *  deleted once the archive is complete.
+             */
+            bool result = false;
+            if (WaitForSingleObject(thread, DEBUG_ARCHIVE_TIMEOUT) == WAIT_OBJECT_0) {
+                DWORD exit_code = 0;
+                GetExitCodeThread(thread, &exit_code);
+                result = (exit_code != 0);
+            } else {
+                DEBUG_WARNING("Timed out waiting for debug archive \"%s\"!\n", buffer);
+            }
 
-    /**
-     *  Cleanup memory.
-     */
-    for (int i = 0; i < files.Count(); ++i) {
-        std::free((void *)files[i]);
+            CloseHandle(thread);
+
+            return result;
+        }
     }
-    files.Delete_All();
 
-    return result;
-#endif
-    return true;
+    CreateZipParamsStruct *params = Vinifera_Create_Zip_Params(buffer, files, Vinifera_DebugDirectory, DEBUG_ARCHIVE_MAX_BYTES, &Vinifera_Collect_Debug_Files_Progress, true);
+
+    return Vinifera_Create_Zip_Thread(params) != 0;
 }
 
 
@@ -48,8 +48,21 @@ void Vinifera_DeveloperMode_Warning_WWMessageBox(const char *msg, ...);
 
 const char *Vinifera_Get_Window_Title(DWORD dwPid);
 
-bool Vinifera_Create_Zip(const char *filename, DynamicVectorClass<const char *> &filelist, const char *path = nullptr);
-bool Vinifera_Collect_Debug_Files();
+/**
+ *  The largest total size of the files collected into a debug archive.
+ */
+#define DEBUG_ARCHIVE_MAX_BYTES (256 * 1024 * 1024)
+
+/**
+ *  How long to wait for the debug archive to be written, in milliseconds.
+ */
+#define DEBUG_ARCHIVE_TIMEOUT (60 * 1000)
+
+typedef void (*ZipProgressCallbackType)(int index, int count, const char *filename);
+
+bool Vinifera_Create_Zip(const char *filename, DynamicVectorClass<const char *> &filelist, const char *path = nullptr, unsigned max_bytes = 0, ZipProgressCallbackType progress = nullptr, bool *added = nullptr);
+HANDLE Vinifera_Create_Zip_Async(const char *filename, DynamicVectorClass<const char *> &filelist, const char *path = nullptr, unsigned max_bytes = 0, ZipProgressCallbackType progress = nullptr, bool move_files = false);
+bool Vinifera_Collect_Debug_Files(bool async = true);
 
 /**
  *  Functions for fetching windows resources.